@@ -0,0 +1,76 @@
+// Times mine placement and full board generation across board sizes and mine
+// densities. Build in Release; prints one row per size/density, best of a few
+// runs, so results can be compared before and after a change.
+
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+#include "GameBoard.h"
+#include "MineSampling.h"
+#include "Rng.h"
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+const int runs = 5;
+
+double elapsedMs(Clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+// best of `runs`, the minimum is the least noisy on a busy machine
+template <class Fn>
+double bestMs(Fn &&fn)
+{
+    double best = 0;
+    for (int run = 0; run < runs; ++run) {
+        const Clock::time_point start = Clock::now();
+        fn(run);
+        const double ms = elapsedMs(start);
+        if (run == 0 || ms < best)
+            best = ms;
+    }
+    return best;
+}
+
+}
+
+int main()
+{
+    const int sizes[] = {100, 300, 1000, 2000};
+    const double densities[] = {0.10, 0.50, 0.90, 0.99};
+
+    std::printf("%-11s %8s %12s %14s %14s %10s\n",
+                "board", "density", "sample ms", "generate ms", "+labels ms", "ns/cell");
+
+    std::vector<char> marks;
+    for (int size : sizes) {
+        for (double density : densities) {
+            Config cfg;
+            cfg.rows = size;
+            cfg.cols = size;
+            cfg.numMines = static_cast<int>(size*size*density);
+            cfg.noGuess = false;
+            const int cells = size*size;
+
+            const double sampleMs = bestMs([&](int run) {
+                Rng rng(run);
+                sampleMines(cells, cfg.numMines, [&](int bound) { return static_cast<int>(rng.below(bound)); }, marks);
+            });
+
+            GameBoard board(FloatRect{0,0,0,0}, cfg, uint64_t(0));
+            board.labelOpenings = false;
+            const double generateMs = bestMs([&](int run) { board.generate(run); });
+            board.labelOpenings = true;
+            const double labelledMs = bestMs([&](int run) { board.generate(run); });
+
+            std::printf("%5dx%-5d %7.0f%% %12.2f %14.2f %14.2f %10.1f\n",
+                        size, size, density*100, sampleMs, generateMs, labelledMs, generateMs*1e6/cells);
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,114 @@
+#include "BitBoard.h"
+
+#include "BitFloodFill.h"
+#include "BitOps.h"
+#include "NeighborKernel.h"
+
+BitBoard::BitBoard(const Config &config) : cfg(config), mineCount(0), flagCount(0) {
+    wordsPerRow = (cfg.cols + 63) / 64;
+    stride = wordsPerRow + 2;
+    clear();
+}
+
+void BitBoard::clear() {
+    const size_t planeWords = static_cast<size_t>(stride) * (cfg.rows + 2);
+
+    mines.assign(planeWords, 0);
+    flagged.assign(planeWords, 0);
+    fillPlane.assign(planeWords, 0);
+    for (auto &plane : neighborBits)
+        plane.assign(planeWords, 0);
+
+    // everything outside the board is a revealed sentinel
+    revealed.assign(planeWords, ~uint64_t(0));
+    for (int y = 0; y < cfg.rows; ++y) {
+        uint64_t *row = &revealed[(y + 1) * stride + 1];
+        for (int w = 0; w < wordsPerRow; ++w) {
+            int cellsInWord = cfg.cols - w * 64;
+            row[w] = cellsInWord >= 64 ? 0 : ~uint64_t(0) << cellsInWord;
+        }
+    }
+
+    mineCount = 0;
+    flagCount = 0;
+}
+
+void BitBoard::loadBoard(const char board[]) {
+    clear();
+
+    for (int y = 0; y < cfg.rows; ++y) {
+        for (int x = 0; x < cfg.cols; ++x) {
+            long off = y*(cfg.cols+1)+x; // +1 for \n in string
+            if (board[off] == '1')
+                setMine({x,y}, true);
+        }
+    }
+    computeNeighbors();
+}
+
+void BitBoard::computeNeighbors() {
+    computeNeighborBits(*this);
+}
+
+void BitBoard::setMine(Vec2i coords, bool mine) {
+    uint64_t &word = mines[wordIndex(coords)];
+    const uint64_t mask = bitMask(coords);
+    if (((word & mask) != 0) == mine)
+        return;
+
+    word ^= mask;
+    mineCount += mine ? 1 : -1;
+}
+
+bool BitBoard::reveal(Vec2i coords) {
+    const int word = wordIndex(coords);
+    const uint64_t mask = bitMask(coords);
+
+    if (mines[word] & mask)
+        return false;
+
+    revealed[word] |= mask;
+    if (flagged[word] & mask) {
+        flagged[word] &= ~mask;
+        flagCount--;
+    }
+    return true;
+}
+
+void BitBoard::floodFill(Vec2i coords) {
+    floodFillBits(*this, coords);
+}
+
+void BitBoard::toggleFlag(Vec2i coords) {
+    const int word = wordIndex(coords);
+    const uint64_t mask = bitMask(coords);
+
+    if (revealed[word] & mask)
+        return;
+
+    flagged[word] ^= mask;
+    flagCount += (flagged[word] & mask) ? 1 : -1;
+}
+
+int BitBoard::neighborCount(Vec2i coords) const {
+    const int word = wordIndex(coords);
+    const int shift = coords.x & 63;
+
+    int count = 0;
+    for (int bit = 0; bit < 4; ++bit)
+        count |= static_cast<int>((neighborBits[bit][word] >> shift) & 1) << bit;
+    return count;
+}
+
+int BitBoard::remainingSafeCells() const {
+    // sentinels are revealed, so anything neither mine nor revealed is a hidden safe cell
+    int remaining = 0;
+    for (size_t i = 0; i < mines.size(); ++i)
+        remaining += popcount64(~(mines[i] | revealed[i]));
+    return remaining;
+}
+
+void BitBoard::flagAllMines() {
+    flagged = mines;
+    flagCount = mineCount;
+}
@@ -0,0 +1,71 @@
+#ifndef MINESWEEPER_BITBOARD_H
+#define MINESWEEPER_BITBOARD_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "BoardTypes.h"
+
+// Bit-plane board store, 64 cells per word.
+//
+// Each row of a plane is `wordsPerRow` words wide plus one guard word on both
+// sides, and the plane has one guard row above and below the board, so any
+// cell's 8 neighbors can be read without bounds checks. Guard and padding bits
+// are zero in every plane except `revealed`, where they are set: they count as
+// revealed sentinels, which lets whole-board queries run over the raw words.
+struct BitBoard {
+    Config cfg;
+    int wordsPerRow;
+    int stride; // wordsPerRow + 2 guard words
+
+    std::vector<uint64_t> mines;
+    std::vector<uint64_t> revealed;
+    std::vector<uint64_t> flagged;
+    std::vector<uint64_t> neighborBits[4]; // bit i of each cell's neighbor count (0 for mines)
+    std::vector<uint64_t> fillPlane;       // scratch for floodFill, all zero between calls
+
+    int mineCount;
+    int flagCount;
+
+    explicit BitBoard(const Config &config);
+
+    // reset to an empty, fully hidden board
+    void clear();
+
+    // same text format as GameBoard::loadBoard ('1' mine, '0' empty, '\n' per row)
+    void loadBoard(const char board[]);
+    void computeNeighbors();
+
+    void setMine(Vec2i coords, bool mine);
+    // reveals a single cell, returns false if it was a mine
+    bool reveal(Vec2i coords);
+    // same reveal rules as GameBoard::floodFill, see BitFloodFill.h
+    void floodFill(Vec2i coords);
+    void toggleFlag(Vec2i coords);
+
+    bool isMine(Vec2i coords) const { return testBit(mines, coords); }
+    bool isRevealed(Vec2i coords) const { return testBit(revealed, coords); }
+    bool isFlagged(Vec2i coords) const { return testBit(flagged, coords); }
+    int neighborCount(Vec2i coords) const;
+
+    // whole board queries, one word (64 cells) at a time
+    int remainingSafeCells() const;
+    bool areWeWinners() const { return remainingSafeCells() == 0; }
+    void flagAllMines();
+
+    int wordIndex(Vec2i coords) const {
+        return (coords.y + 1) * stride + 1 + (coords.x >> 6);
+    }
+
+    static uint64_t bitMask(Vec2i coords) {
+        return uint64_t(1) << (coords.x & 63);
+    }
+
+private:
+    bool testBit(const std::vector<uint64_t> &plane, Vec2i coords) const {
+        return (plane[wordIndex(coords)] & bitMask(coords)) != 0;
+    }
+};
+
+#endif //MINESWEEPER_BITBOARD_H
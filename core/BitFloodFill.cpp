@@ -0,0 +1,114 @@
+#include "BitFloodFill.h"
+
+#include <algorithm>
+
+#include "BitBoard.h"
+#include "BitOps.h"
+
+namespace {
+
+// hidden zero cells of a word; guard and padding bits are revealed, so they drop out
+inline uint64_t hiddenZeros(const BitBoard &board, int index) {
+    return ~(board.mines[index] | board.revealed[index] | board.neighborBits[0][index] |
+             board.neighborBits[1][index] | board.neighborBits[2][index] | board.neighborBits[3][index]);
+}
+
+// a word's cells plus their west and east neighbors, carrying across word edges
+inline uint64_t spread(const uint64_t *word) {
+    return word[0] | (word[0] << 1) | (word[-1] >> 63) | (word[0] >> 1) | (word[1] << 63);
+}
+
+// grows `seeds` along runs of `open` cells inside one word, in both directions
+inline uint64_t fillRuns(uint64_t seeds, uint64_t open) {
+    uint64_t up = seeds & open, upOpen = open;
+    uint64_t down = up, downOpen = open;
+    for (int shift = 1; shift < 64; shift <<= 1) {
+        up |= upOpen & (up << shift);
+        upOpen &= upOpen << shift;
+        down |= downOpen & (down >> shift);
+        downOpen &= downOpen >> shift;
+    }
+    return up | down;
+}
+
+// reached region in plane coordinates: rows 1..cfg.rows, words 1..wordsPerRow
+struct Box {
+    int top, bottom, left, right;
+    int lastRow, lastWord;
+
+    // the box grown by one row/word on each side, clipped to the board
+    int rowMin() const { return std::max(top-1, 1); }
+    int rowMax() const { return std::min(bottom+1, lastRow); }
+    int wordMin() const { return std::max(left-1, 1); }
+    int wordMax() const { return std::min(right+1, lastWord); }
+
+    void add(int row, int word) {
+        if (row < top) top = row;
+        if (row > bottom) bottom = row;
+        if (word < left) left = word;
+        if (word > right) right = word;
+    }
+};
+
+}
+
+void floodFillBits(BitBoard &board, Vec2i coords) {
+    if (board.isRevealed(coords) || board.isMine(coords))
+        return;
+    if (board.neighborCount(coords) != 0) {
+        board.reveal(coords);
+        return;
+    }
+
+    const int stride = board.stride;
+    uint64_t *region = board.fillPlane.data();
+
+    const int seed = board.wordIndex(coords);
+    region[seed] = BitBoard::bitMask(coords);
+    const int seedWord = 1 + (coords.x >> 6);
+    Box box = {coords.y+1, coords.y+1, seedWord, seedWord, board.cfg.rows, board.wordsPerRow};
+
+    // dilate until a sweep over the box (plus one row/word around it) adds
+    // nothing; the bounds are re-read as the box grows, so a sweep keeps
+    // going in its own direction for as far as the opening reaches
+    bool changed = true;
+    for (bool downward = true; changed; downward = !downward) {
+        changed = false;
+        const int step = downward ? 1 : -1;
+        for (int row = downward ? box.rowMin() : box.rowMax(); row >= box.rowMin() && row <= box.rowMax(); row += step) {
+            for (int w = downward ? box.wordMin() : box.wordMax(); w >= box.wordMin() && w <= box.wordMax(); w += step) {
+                const int index = row*stride + w;
+                const uint64_t open = hiddenZeros(board, index);
+                if (!open)
+                    continue;
+
+                const uint64_t reach = spread(region + index - stride) | spread(region + index) |
+                                       spread(region + index + stride);
+                const uint64_t grown = fillRuns(reach & open, open);
+                if (grown != region[index]) {
+                    region[index] = grown;
+                    box.add(row, w);
+                    changed = true;
+                }
+            }
+        }
+    }
+
+    // reveal the region and its border, then leave the scratch plane clear again
+    for (int row = box.rowMin(); row <= box.rowMax(); ++row) {
+        for (int w = box.wordMin(); w <= box.wordMax(); ++w) {
+            const int index = row*stride + w;
+            const uint64_t reveal = (spread(region + index - stride) | spread(region + index) |
+                                     spread(region + index + stride)) & ~board.revealed[index];
+            if (reveal & board.flagged[index]) {
+                board.flagCount -= popcount64(reveal & board.flagged[index]);
+                board.flagged[index] &= ~reveal;
+            }
+            board.revealed[index] |= reveal;
+        }
+    }
+    for (int row = box.top; row <= box.bottom; ++row) {
+        for (int w = box.left; w <= box.right; ++w)
+            region[row*stride + w] = 0;
+    }
+}
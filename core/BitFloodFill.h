@@ -0,0 +1,16 @@
+#ifndef MINESWEEPER_BITFLOODFILL_H
+#define MINESWEEPER_BITFLOODFILL_H
+
+#include "BoardTypes.h"
+
+struct BitBoard;
+
+// Reveals like GameBoard::floodFill, 64 cells per word: the opening around a
+// hidden zero cell is grown by word-wide dilation (rows above/below and the
+// west/east shifted words, then a log-step fill along runs inside each word)
+// until nothing changes, alternating top-down and bottom-up sweeps over the
+// bounding box of what has been reached so far. The opening and its numbered
+// border are then revealed a word at a time.
+void floodFillBits(BitBoard &board, Vec2i coords);
+
+#endif //MINESWEEPER_BITFLOODFILL_H
@@ -0,0 +1,17 @@
+#ifndef MINESWEEPER_BITOPS_H
+#define MINESWEEPER_BITOPS_H
+
+#include <cstdint>
+
+inline int popcount64(uint64_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_popcountll(word);
+#else
+    word = word - ((word >> 1) & 0x5555555555555555ull);
+    word = (word & 0x3333333333333333ull) + ((word >> 2) & 0x3333333333333333ull);
+    word = (word + (word >> 4)) & 0x0f0f0f0f0f0f0f0full;
+    return static_cast<int>((word * 0x0101010101010101ull) >> 56);
+#endif
+}
+
+#endif //MINESWEEPER_BITOPS_H
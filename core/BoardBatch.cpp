@@ -0,0 +1,76 @@
+#include "BoardBatch.h"
+
+#include <algorithm>
+
+#include "MineSampling.h"
+#include "ThreadPool.h"
+
+namespace {
+
+// per-thread scratch so generating a board does not allocate
+struct BatchScratch {
+    std::vector<char> marks;  // row-major mine marks
+    std::vector<char> padded; // marks with a one-cell empty ring, for bounds-free counting
+};
+
+void generateBoard(const Config &cfg, uint64_t seed, uint64_t *out, int mineWords, int countWords, BatchScratch &scratch) {
+    std::fill(out, out + mineWords + countWords, 0);
+
+    const int cells = cfg.rows*cfg.cols;
+    const int stride = cfg.cols+2;
+
+    Rng rng(seed);
+    sampleMines(cells, cfg.numMines, [&](int bound) { return static_cast<int>(rng.below(bound)); }, scratch.marks);
+
+    scratch.padded.assign(stride*(cfg.rows+2), 0);
+    uint64_t *mines = out;
+    uint64_t *counts = out + mineWords;
+
+    for (int cell = 0; cell < cells; ++cell) {
+        if (scratch.marks[cell]) {
+            mines[cell >> 6] |= uint64_t(1) << (cell & 63);
+            scratch.padded[(cell/cfg.cols+1)*stride + cell%cfg.cols+1] = 1;
+        }
+    }
+
+    for (int y = 0; y < cfg.rows; ++y) {
+        const char *row = &scratch.padded[(y+1)*stride+1];
+        for (int x = 0; x < cfg.cols; ++x) {
+            if (row[x])
+                continue;
+
+            const uint64_t count = row[x-stride-1] + row[x-stride] + row[x-stride+1] +
+                                   row[x-1] +                        row[x+1] +
+                                   row[x+stride-1] + row[x+stride] + row[x+stride+1];
+            const int cell = y*cfg.cols+x;
+            counts[cell >> 4] |= count << ((cell & 15) * 4);
+        }
+    }
+}
+
+}
+
+BoardBatch::BoardBatch(const Config &config, size_t count) : cfg(config), count(count), baseSeed(0) {
+    const int cells = cfg.rows*cfg.cols;
+    mineWords = (cells + 63) / 64;
+    countWords = (cells + 15) / 16;
+    wordsPerBoard = mineWords + countWords;
+    data.resize(count * wordsPerBoard);
+}
+
+void generateBoards(BoardBatch &batch, uint64_t baseSeed, ThreadPool &pool) {
+    batch.baseSeed = baseSeed;
+
+    // enough boards per block to amortize the hand-off, small enough to balance
+    const size_t grain = std::max<size_t>(1, 4096 / (batch.cfg.rows*batch.cfg.cols/64 + 1));
+
+    pool.parallelFor(batch.count, grain, [&](size_t begin, size_t end) {
+        // one per thread for the thread's lifetime, so the buffers are sized
+        // once per worker and not again for every block
+        static thread_local BatchScratch scratch;
+        for (size_t board = begin; board < end; ++board) {
+            generateBoard(batch.cfg, BoardBatch::boardSeed(baseSeed, board),
+                          &batch.data[board*batch.wordsPerBoard], batch.mineWords, batch.countWords, scratch);
+        }
+    });
+}
@@ -0,0 +1,49 @@
+#ifndef MINESWEEPER_BOARDBATCH_H
+#define MINESWEEPER_BOARDBATCH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "BoardTypes.h"
+#include "Rng.h"
+
+struct ThreadPool;
+
+// Compact layouts of many boards with the same Config in one contiguous,
+// preallocated buffer. Board i takes `wordsPerBoard` words at i*wordsPerBoard:
+// its mine bitset (one bit per cell, row-major) followed by its neighbor
+// counts packed 16 cells per word, 4 bits each (0 for mines).
+struct BoardBatch {
+    Config cfg;
+    size_t count;
+    int mineWords;
+    int countWords;
+    int wordsPerBoard;
+    uint64_t baseSeed;
+    std::vector<uint64_t> data;
+
+    BoardBatch(const Config &config, size_t count);
+
+    // board i is the board GameBoard::generate(boardSeed(baseSeed, i)) gives
+    static uint64_t boardSeed(uint64_t baseSeed, size_t board) {
+        return splitmix64(baseSeed ^ splitmix64(board));
+    }
+
+    const uint64_t *mines(size_t board) const { return &data[board*wordsPerBoard]; }
+    const uint64_t *counts(size_t board) const { return mines(board) + mineWords; }
+
+    bool isMine(size_t board, int cell) const {
+        return (mines(board)[cell >> 6] >> (cell & 63)) & 1;
+    }
+
+    int neighborCount(size_t board, int cell) const {
+        return static_cast<int>((counts(board)[cell >> 4] >> ((cell & 15) * 4)) & 0xf);
+    }
+};
+
+// Fills every board of `batch` across the pool. Each board depends only on
+// its own seed, so the output is identical for any number of threads.
+void generateBoards(BoardBatch &batch, uint64_t baseSeed, ThreadPool &pool);
+
+#endif //MINESWEEPER_BOARDBATCH_H
@@ -0,0 +1,100 @@
+#ifndef MINESWEEPER_BOARDGRID_H
+#define MINESWEEPER_BOARDGRID_H
+
+// Index math for the sentinel-bordered tile storage: a rows x cols board is
+// stored in a (rows+2) x (cols+2) grid. The board kernels are templated on the
+// grid type so preset sizes get compile-time strides.
+
+#include "BoardTypes.h"
+
+enum class TileStorage {
+    RowMajor,
+    Chunked // 64x64 cell chunks, for boards too wide for row-major locality
+};
+
+struct DynamicGrid {
+    int rows, cols;
+    int stride;
+    int offsets[8];
+
+    DynamicGrid(int rows, int cols) : rows(rows), cols(cols), stride(cols+2),
+            offsets{-stride-1, -stride, -stride+1,
+                    -1,                 +1,
+                    stride-1,  stride,  stride+1} {}
+
+    int size() const { return stride*(rows+2); }
+    int index(int x, int y) const { return (y+1)*stride+x+1; }
+    int neighbor(int index, int k) const { return index+offsets[k]; }
+    Vec2i coords(int index) const { return {index%stride-1, index/stride-1}; }
+};
+
+template <int Rows, int Cols>
+struct FixedGrid {
+    static constexpr int rows = Rows;
+    static constexpr int cols = Cols;
+    static constexpr int stride = Cols+2;
+    static constexpr int offsets[8] = {-stride-1, -stride, -stride+1,
+                                       -1,                 +1,
+                                       stride-1,  stride,  stride+1};
+
+    // same constructor shape as DynamicGrid so kernels can build either
+    FixedGrid(int, int) {}
+
+    static constexpr int size() { return stride*(Rows+2); }
+    static constexpr int index(int x, int y) { return (y+1)*stride+x+1; }
+    static constexpr int neighbor(int index, int k) { return index+offsets[k]; }
+};
+
+template <int Rows, int Cols>
+constexpr int FixedGrid<Rows, Cols>::offsets[8];
+
+// The padded grid split into 64x64 chunks, each stored contiguously (row-major
+// inside the chunk, chunks row-major), so flood fills on very wide boards stay
+// within a few chunks instead of striding a full board row per step.
+struct ChunkedGrid {
+    static const int chunkShift = 6;
+    static const int chunkSize = 1 << chunkShift;
+    static const int chunkMask = chunkSize-1;
+    static const int chunkCells = chunkSize*chunkSize;
+
+    int rows, cols;
+    int chunksX, chunksY;
+
+    ChunkedGrid(int rows, int cols) : rows(rows), cols(cols),
+            chunksX((cols+2+chunkMask) >> chunkShift), chunksY((rows+2+chunkMask) >> chunkShift) {}
+
+    int size() const { return chunksX*chunksY*chunkCells; }
+
+    // px/py are padded coordinates, the sentinel ring sits at 0 and cols+1/rows+1
+    int slot(int px, int py) const {
+        const int chunk = (py >> chunkShift)*chunksX + (px >> chunkShift);
+        return chunk*chunkCells + ((py & chunkMask) << chunkShift) + (px & chunkMask);
+    }
+
+    int index(int x, int y) const { return slot(x+1, y+1); }
+
+    int neighbor(int index, int k) const {
+        static const int dx[8] = {-1, 0, 1, -1, 1, -1, 0, 1};
+        static const int dy[8] = {-1, -1, -1, 0, 0, 1, 1, 1};
+
+        const int local = index & (chunkCells-1);
+        const int lx = local & chunkMask;
+        const int ly = local >> chunkShift;
+        if (lx > 0 && lx < chunkMask && ly > 0 && ly < chunkMask)
+            return index + dy[k]*chunkSize + dx[k]; // stays inside the chunk
+
+        const int chunk = index / chunkCells;
+        const int px = (chunk % chunksX)*chunkSize + lx;
+        const int py = (chunk / chunksX)*chunkSize + ly;
+        return slot(px+dx[k], py+dy[k]);
+    }
+
+    Vec2i coords(int index) const {
+        const int chunk = index / chunkCells;
+        const int local = index & (chunkCells-1);
+        return {(chunk % chunksX)*chunkSize + (local & chunkMask) - 1,
+                (chunk / chunksX)*chunkSize + (local >> chunkShift) - 1};
+    }
+};
+
+#endif //MINESWEEPER_BOARDGRID_H
@@ -0,0 +1,63 @@
+#include "BoardJob.h"
+
+#include <cstring>
+
+#include "GameBoard.h"
+#include "Solver.h"
+
+BoardJob::BoardJob(const Config &config, TileStorage storage)
+        : cfg(config), storage(storage), done(false), started(false) {}
+
+BoardJob::~BoardJob() {
+    wait();
+}
+
+void BoardJob::startGenerate(uint64_t seed) {
+    launch(Generate, seed, Vec2i{0,0}, nullptr);
+}
+
+void BoardJob::startNoGuess(Vec2i firstClick, uint64_t seed) {
+    launch(NoGuess, seed, firstClick, nullptr);
+}
+
+void BoardJob::startLoad(const char *board) {
+    launch(Load, 0, Vec2i{0,0}, board);
+}
+
+void BoardJob::launch(Kind kind, uint64_t seed, Vec2i firstClick, const char *board) {
+    // the running worker may still read `text`
+    wait();
+    if (board)
+        text.assign(board, board + std::strlen(board) + 1);
+    done = false;
+    started = true;
+
+    worker = std::thread([this, kind, seed, firstClick] {
+        // a new board already holds generate(seed)
+        if (!result)
+            result.reset(new GameBoard(FloatRect{0,0,0,0}, cfg, seed, storage));
+        else if (kind == Generate)
+            result->generate(seed);
+
+        if (kind == Load)
+            result->loadBoard(text.data());
+        else if (kind == NoGuess)
+            generateNoGuess(*result, firstClick, seed);
+        done = true;
+    });
+}
+
+void BoardJob::wait() {
+    if (worker.joinable())
+        worker.join();
+}
+
+bool BoardJob::poll(GameBoard &board) {
+    if (!started || !done)
+        return false;
+
+    wait();
+    board.swapState(*result);
+    started = false;
+    return true;
+}
@@ -0,0 +1,55 @@
+#ifndef MINESWEEPER_BOARDJOB_H
+#define MINESWEEPER_BOARDJOB_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "BoardGrid.h"
+#include "BoardTypes.h"
+
+struct GameBoard;
+
+// Generates or loads one board on a worker thread so the render thread keeps
+// drawing meanwhile; poll() swaps the result in once it is done. One job at a
+// time, starting another blocks until the running one is done, so callers on
+// the render thread should check running() first.
+struct BoardJob {
+    explicit BoardJob(const Config &config, TileStorage storage = TileStorage::RowMajor);
+    ~BoardJob();
+
+    BoardJob(const BoardJob &) = delete;
+    BoardJob &operator=(const BoardJob &) = delete;
+
+    void startGenerate(uint64_t seed);
+    // generateNoGuess() around the first click, the slow case: it can play
+    // through thousands of boards before one qualifies
+    void startNoGuess(Vec2i firstClick, uint64_t seed);
+    // copies the board text (GameBoard::loadBoard format)
+    void startLoad(const char *board);
+
+    bool running() const { return started; }
+
+    // if the job finished, swaps the new board into `board` (same Config and
+    // TileStorage)
+    // and returns true
+    bool poll(GameBoard &board);
+
+private:
+    enum Kind { Generate, Load, NoGuess };
+
+    Config cfg;
+    TileStorage storage;
+    std::unique_ptr<GameBoard> result; // built and filled on the worker
+    std::vector<char> text;
+    std::thread worker;
+    std::atomic<bool> done;
+    bool started;
+
+    void launch(Kind kind, uint64_t seed, Vec2i firstClick, const char *board);
+    void wait();
+};
+
+#endif //MINESWEEPER_BOARDJOB_H
@@ -0,0 +1,218 @@
+#include "BoardKernels.h"
+
+#include <cstdint>
+
+#include "BoardGrid.h"
+#include "GameBoard.h"
+#include "NeighborKernel.h"
+
+namespace {
+
+// storage index of cell x of row y, whose cell 0 is at rowIndex; rows are
+// contiguous in the row-major grids, chunked storage splits them
+template <class Grid>
+inline int cellInRow(const Grid &, int rowIndex, int x, int) {
+    return rowIndex + x;
+}
+
+inline int cellInRow(const ChunkedGrid &grid, int, int x, int y) {
+    return grid.index(x, y);
+}
+
+// Unpacks the planes into the board cells a word (64 cells) at a time. With
+// wholeTiles every cell becomes a fresh hidden tile, otherwise only the counts
+// are written and the player state stays. Mines get a count of 0.
+template <class Grid, bool wholeTiles>
+void unpackPlanes(const Grid &grid, GameBoard &board, const NeighborPlanes &planes) {
+    Tile *tiles = board.tiles.data();
+
+    for (int y = 0; y < grid.rows; ++y) {
+        const int rowStart = (y+1)*planes.stride + 1;
+        const int rowIndex = grid.index(0,y);
+        for (int w = 0; w < planes.wordsPerRow; ++w) {
+            uint64_t mine = planes.mines[rowStart+w];
+            uint64_t bit0 = planes.counts[0][rowStart+w];
+            uint64_t bit1 = planes.counts[1][rowStart+w];
+            uint64_t bit2 = planes.counts[2][rowStart+w];
+            uint64_t bit3 = planes.counts[3][rowStart+w];
+
+            const int end = w*64+64 < grid.cols ? w*64+64 : grid.cols;
+            for (int x = w*64; x < end; ++x) {
+                const int count = static_cast<int>((bit0 & 1) | (bit1 & 1) << 1 | (bit2 & 1) << 2 | (bit3 & 1) << 3);
+                Tile &tile = tiles[cellInRow(grid, rowIndex, x, y)];
+                if (wholeTiles) {
+                    // built whole and stored once, not field by field
+                    Tile fresh;
+                    fresh.isMine = (mine & 1) != 0;
+                    fresh.numNeighbors = count;
+                    tile = fresh;
+                } else {
+                    tile.numNeighbors = count;
+                }
+                mine >>= 1;
+                bit0 >>= 1;
+                bit1 >>= 1;
+                bit2 >>= 1;
+                bit3 >>= 1;
+            }
+        }
+    }
+}
+
+// recounts from the tiles' mines through a bit plane, keeping player state
+template <class Grid>
+void computeNeighbors(GameBoard &board) {
+    const Grid grid(board.cfg.rows, board.cfg.cols);
+    const Tile *tiles = board.tiles.data();
+
+    NeighborPlaneStore store(grid.rows, grid.cols);
+    for (int y = 0; y < grid.rows; ++y) {
+        uint64_t *row = store.row(y);
+        const int rowIndex = grid.index(0,y);
+        for (int x = 0; x < grid.cols; ++x)
+            row[x >> 6] |= uint64_t(tiles[cellInRow(grid, rowIndex, x, y)].isMine) << (x & 63);
+    }
+
+    computeNeighborBits(store.planes);
+    unpackPlanes<Grid, false>(grid, board, store.planes);
+}
+
+template <class Grid>
+void writeTiles(GameBoard &board, const NeighborPlanes &planes) {
+    const Grid grid(board.cfg.rows, board.cfg.cols);
+    unpackPlanes<Grid, true>(grid, board, planes);
+}
+
+// neighbor slots used to walk rows (see the offset order in BoardGrid.h)
+const int northWest = 0, west = 3, east = 4, southWest = 5;
+
+// Reveals the hidden run of zero cells through `index` (itself a hidden
+// zero), pushes it as a span and returns how many cells it reaches east.
+template <class Grid>
+int revealSpan(const Grid &grid, GameBoard &board, int index, std::vector<int> &spans) {
+    const Tile *tiles = board.tiles.data();
+    board.revealTile(index);
+
+    int left = index;
+    int length = 1;
+    for (int next = grid.neighbor(left,west); !tiles[next].isRevealed && tiles[next].numNeighbors == 0;
+         next = grid.neighbor(left,west)) {
+        board.revealTile(next);
+        left = next;
+        ++length;
+    }
+
+    int eastward = 0;
+    for (int right = index, next = grid.neighbor(right,east); !tiles[next].isRevealed && tiles[next].numNeighbors == 0;
+         right = next, next = grid.neighbor(right,east)) {
+        board.revealTile(next);
+        ++length;
+        ++eastward;
+    }
+
+    spans.push_back(left);
+    spans.push_back(length);
+    return eastward;
+}
+
+// Scanline reveal: openings are handled as horizontal runs of zero cells.
+// Each run reveals its own row's end cells and scans the rows above and
+// below once, revealing the numbered border and starting new runs at hidden
+// zeros, so every cell is looked at a bounded number of times and mostly in
+// memory order. A zero's neighbors are never mines, so no mine checks are
+// needed past the seeds. Pending runs live in the board's reusable
+// fillStack as (leftmost index, length) pairs; all seeds share one stack.
+template <class Grid>
+void floodFill(GameBoard &board, const int *seeds, int count) {
+    const Grid grid(board.cfg.rows, board.cfg.cols);
+    const Tile *tiles = board.tiles.data();
+
+    std::vector<int> &spans = board.fillStack;
+    spans.clear();
+
+    for (int i = 0; i < count; ++i) {
+        const int index = seeds[i];
+
+        // sentinels are revealed, so this also stops at the board edge;
+        // seeds inside an opening an earlier seed filled are skipped here
+        if (tiles[index].isRevealed || tiles[index].isMine)
+            continue;
+
+        if (tiles[index].numNeighbors != 0)
+            board.revealTile(index);
+        else
+            revealSpan(grid, board, index, spans);
+    }
+
+    while (!spans.empty()) {
+        const int length = spans.back();
+        spans.pop_back();
+        const int left = spans.back();
+        spans.pop_back();
+
+        // the cells just past both ends of the run are numbers (or already revealed)
+        const int beforeLeft = grid.neighbor(left,west);
+        if (!tiles[beforeLeft].isRevealed)
+            board.revealTile(beforeLeft);
+
+        int right = left;
+        for (int i = 1; i < length; ++i)
+            right = grid.neighbor(right,east);
+        const int afterRight = grid.neighbor(right,east);
+        if (!tiles[afterRight].isRevealed)
+            board.revealTile(afterRight);
+
+        // rows above and below, from one cell before the run to one cell after it
+        const int rowStarts[2] = {grid.neighbor(left,northWest), grid.neighbor(left,southWest)};
+        for (int cell : rowStarts) {
+            for (int i = 0; i < length+2; ++i, cell = grid.neighbor(cell,east)) {
+                if (tiles[cell].isRevealed)
+                    continue;
+
+                if (tiles[cell].numNeighbors != 0) {
+                    board.revealTile(cell);
+                    continue;
+                }
+
+                const int eastward = revealSpan(grid, board, cell, spans);
+                for (int skip = 0; skip < eastward && i+1 < length+2; ++skip) {
+                    cell = grid.neighbor(cell,east);
+                    ++i;
+                }
+            }
+        }
+    }
+}
+
+template <class Grid>
+BoardKernels makeKernels(const char *name) {
+    return BoardKernels{name, &computeNeighbors<Grid>, &writeTiles<Grid>, &floodFill<Grid>};
+}
+
+struct Preset {
+    int rows, cols;
+    BoardKernels kernels;
+};
+
+const Preset presets[] = {
+        {9,  9,  makeKernels<FixedGrid<9,9> >("beginner 9x9")},
+        {16, 16, makeKernels<FixedGrid<16,16> >("intermediate 16x16")},
+        {16, 30, makeKernels<FixedGrid<16,30> >("expert 30x16")},
+        {16, 25, makeKernels<FixedGrid<16,25> >("config 25x16")},
+};
+
+const BoardKernels dynamicKernels = makeKernels<DynamicGrid>("dynamic");
+const BoardKernels chunkedKernels = makeKernels<ChunkedGrid>("chunked");
+
+}
+
+const BoardKernels *selectKernels(const Config &cfg, TileStorage storage) {
+    if (storage == TileStorage::Chunked)
+        return &chunkedKernels;
+
+    for (const Preset &preset : presets) {
+        if (preset.rows == cfg.rows && preset.cols == cfg.cols)
+            return &preset.kernels;
+    }
+    return &dynamicKernels;
+}
@@ -0,0 +1,24 @@
+#ifndef MINESWEEPER_BOARDKERNELS_H
+#define MINESWEEPER_BOARDKERNELS_H
+
+#include "BoardGrid.h"
+#include "BoardTypes.h"
+
+struct GameBoard;
+struct NeighborPlanes;
+
+// Hot board loops, instantiated once per grid type (see BoardGrid.h).
+struct BoardKernels {
+    const char *name;
+    void (*computeNeighbors)(GameBoard &board);
+    // writes every board cell as a hidden tile from filled planes (NeighborKernel.h)
+    void (*writeTiles)(GameBoard &board, const NeighborPlanes &planes);
+    // reveals from several seeds (storage indices) in one pass, so openings
+    // reached from more than one seed are only filled once
+    void (*floodFill)(GameBoard &board, const int *seeds, int count);
+};
+
+// compile-time sized kernels for the standard presets, runtime sized ones otherwise
+const BoardKernels *selectKernels(const Config &cfg, TileStorage storage);
+
+#endif //MINESWEEPER_BOARDKERNELS_H
@@ -0,0 +1,58 @@
+#ifndef MINESWEEPER_BOARDLAYOUT_H
+#define MINESWEEPER_BOARDLAYOUT_H
+
+#include "BoardTypes.h"
+
+// Screen geometry of the board. Tile rects are a pure function of the parent
+// rect and the board size, so they are computed on demand instead of stored.
+struct BoardLayout {
+    FloatRect parentRect;
+    int rows, cols;
+
+    FloatRect tileRect(Vec2i coords) const {
+        float tileX = parentRect.left + static_cast<float>(coords.x)/static_cast<float>(cols) * parentRect.width;
+        float tileY = parentRect.top + static_cast<float>(coords.y)/static_cast<float>(rows) * parentRect.height;
+        float tileWidth = parentRect.width / static_cast<float>(cols);
+        float tileHeight = parentRect.height / static_cast<float>(rows);
+
+        return FloatRect{tileX,tileY,tileWidth,tileHeight};
+    }
+
+    FloatRect tileRect(int index) const {
+        return tileRect(tileCoords(index));
+    }
+
+    // row-major cell index, independent of how the board stores its tiles
+    int tileIndex(Vec2i coords) const {
+        return coords.y*cols+coords.x;
+    }
+
+    Vec2i tileCoords(int index) const {
+        return Vec2i{index%cols, index/cols};
+    }
+
+    // Tile under a point, in constant time. The cell is estimated from the
+    // position, then the 3x3 cells around it are tested with tileRect() in
+    // row-major order, so float rounding at shared edges resolves exactly
+    // like testing every tile in order would.
+    bool tileAt(const Vec2f &point, Vec2i &coords) const {
+        const float fx = (point.x - parentRect.left) / parentRect.width * static_cast<float>(cols);
+        const float fy = (point.y - parentRect.top) / parentRect.height * static_cast<float>(rows);
+        if (!(fx > -1.0f && fx < cols + 1.0f && fy > -1.0f && fy < rows + 1.0f))
+            return false; // also catches NaN from an empty parent rect
+
+        const int cx = static_cast<int>(fx + 1.0f) - 1; // floor, fx > -1
+        const int cy = static_cast<int>(fy + 1.0f) - 1;
+        for (int y = cy-1; y <= cy+1; ++y) {
+            for (int x = cx-1; x <= cx+1; ++x) {
+                if (x >= 0 && x < cols && y >= 0 && y < rows && tileRect({x,y}).contains(point)) {
+                    coords = {x,y};
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+};
+
+#endif //MINESWEEPER_BOARDLAYOUT_H
@@ -0,0 +1,66 @@
+#include "BoardPool.h"
+
+#include "GameBoard.h"
+
+BoardPool::BoardPool(const Config &config, int capacity, TileStorage storage)
+        : cfg(config), storage(storage), slots(capacity), head(0), count(0), stopping(false), seeds(randomSeed()) {
+    if (!cfg.noGuess)
+        worker = std::thread(&BoardPool::workerLoop, this);
+}
+
+BoardPool::~BoardPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    spaceFree.notify_one();
+    if (worker.joinable())
+        worker.join();
+}
+
+bool BoardPool::take(GameBoard &board) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (count == 0)
+            return false;
+
+        // the consumed board goes back into the ring to be regenerated
+        board.swapState(*slots[head]);
+        head = (head + 1) % static_cast<int>(slots.size());
+        count--;
+    }
+    spaceFree.notify_one();
+    return true;
+}
+
+int BoardPool::ready() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return count;
+}
+
+void BoardPool::workerLoop() {
+    const int capacity = static_cast<int>(slots.size());
+
+    for (;;) {
+        int slot;
+        uint64_t seed;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            spaceFree.wait(lock, [&] { return stopping || count < capacity; });
+            if (stopping)
+                return;
+
+            // slots past the ready range are owned by this thread until count grows
+            slot = (head + count) % capacity;
+            seed = seeds.next();
+        }
+
+        if (!slots[slot])
+            slots[slot].reset(new GameBoard(FloatRect{0,0,0,0}, cfg, seed, storage));
+        else
+            slots[slot]->generate(seed);
+
+        std::lock_guard<std::mutex> lock(mutex);
+        count++;
+    }
+}
@@ -0,0 +1,50 @@
+#ifndef MINESWEEPER_BOARDPOOL_H
+#define MINESWEEPER_BOARDPOOL_H
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "BoardGrid.h"
+#include "BoardTypes.h"
+#include "Rng.h"
+
+struct GameBoard;
+
+// Keeps a small ring of freshly generated boards for one Config, refilled by
+// a background thread, so a restart swaps in a ready board in constant time
+// instead of generating on the render thread. No-guess boards depend on the
+// first click, so with cfg.noGuess the pool stays empty and take() always
+// returns false.
+struct BoardPool {
+    BoardPool(const Config &config, int capacity = 4, TileStorage storage = TileStorage::RowMajor);
+    ~BoardPool();
+
+    BoardPool(const BoardPool &) = delete;
+    BoardPool &operator=(const BoardPool &) = delete;
+
+    // swaps the oldest prepared board into `board` (same Config), returns
+    // false if none is ready yet and the caller should generate itself
+    bool take(GameBoard &board);
+
+    int ready();
+
+private:
+    Config cfg;
+    TileStorage storage; // must match the boards take() swaps into
+    std::vector<std::unique_ptr<GameBoard> > slots;
+    int head;  // oldest ready slot
+    int count; // ready slots
+    bool stopping;
+    Rng seeds;
+
+    std::mutex mutex;
+    std::condition_variable spaceFree;
+    std::thread worker;
+
+    void workerLoop();
+};
+
+#endif //MINESWEEPER_BOARDPOOL_H
@@ -0,0 +1,46 @@
+#ifndef MINESWEEPER_BOARDTYPES_H
+#define MINESWEEPER_BOARDTYPES_H
+
+// plain coordinate types so the engine does not depend on SFML
+
+struct Vec2i {
+    int x, y;
+};
+
+inline bool operator==(const Vec2i &a, const Vec2i &b) {
+    return a.x == b.x && a.y == b.y;
+}
+
+inline bool operator!=(const Vec2i &a, const Vec2i &b) {
+    return !(a == b);
+}
+
+struct Vec2f {
+    float x, y;
+};
+
+struct FloatRect {
+    float left, top, width, height;
+
+    // same edge rules as sf::FloatRect: left/top inclusive, right/bottom exclusive
+    bool contains(const Vec2f &point) const {
+        return point.x >= left && point.x < left + width &&
+               point.y >= top && point.y < top + height;
+    }
+};
+
+struct Tile {
+    bool isFlagged;
+    bool isMine;
+    bool isRevealed;
+    int numNeighbors; // if !isMine
+
+    Tile() : isFlagged(0), isMine(0), isRevealed(0), numNeighbors(0) {}
+};
+
+struct Config {
+    int rows,cols,numMines;
+    bool noGuess; // only hand out boards the solver clears from the first click
+};
+
+#endif //MINESWEEPER_BOARDTYPES_H
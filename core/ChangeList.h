@@ -0,0 +1,46 @@
+#ifndef MINESWEEPER_CHANGELIST_H
+#define MINESWEEPER_CHANGELIST_H
+
+#include <cstddef>
+#include <vector>
+
+#include "BoardTypes.h"
+
+// one changed tile: its storage index (GameBoard::tileCoords maps it back to
+// board coordinates) and the tile's state right after the change
+struct TileChange {
+    int index;
+    Tile tile;
+};
+
+// Tile changes in the order they happened, kept until the consumer calls
+// clear(). Whole-board operations (generate, load, swapState), or more changes
+// than `limit`, drop the entries and set fullRefresh instead, so the buffer
+// stays small and the consumer simply rescans the board once.
+struct ChangeList {
+    std::vector<TileChange> entries;
+    bool fullRefresh = false;
+    size_t limit = 0;
+
+    void record(int index, const Tile &tile) {
+        if (fullRefresh)
+            return;
+        if (entries.size() >= limit) {
+            markFullRefresh();
+            return;
+        }
+        entries.push_back(TileChange{index, tile});
+    }
+
+    void markFullRefresh() {
+        fullRefresh = true;
+        entries.clear();
+    }
+
+    void clear() {
+        fullRefresh = false;
+        entries.clear();
+    }
+};
+
+#endif //MINESWEEPER_CHANGELIST_H
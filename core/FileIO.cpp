@@ -0,0 +1,48 @@
+#include "FileIO.h"
+
+#include <cstdio>
+
+char *loadFile(const char *path)
+{
+    FILE *file = fopen(path, "rb");
+
+    if (file != nullptr) {
+        fseek(file, 0, SEEK_END);
+        long size = ftell(file);
+        fseek(file, 0, SEEK_SET);
+
+        char *data = new char[size +1]();
+        fread(data,1,size,file);
+        data[size]='\0';
+
+        fclose(file);
+
+        return data;
+    } else {
+        fprintf(stderr, "Failed to load file %s!\n", path);
+    }
+
+    return nullptr;
+}
+
+
+bool loadConfig(Config *config, const char *filename)
+{
+    FILE *fp = fopen(filename, "rb");
+
+    if (fp != nullptr) {
+        fscanf(fp,"%d",&config->cols);
+        fscanf(fp,"%d",&config->rows);
+        fscanf(fp,"%d",&config->numMines);
+
+        // optional fourth value, 1 for no-guess boards
+        int noGuess = 0;
+        fscanf(fp,"%d",&noGuess);
+        config->noGuess = noGuess != 0;
+
+        fclose(fp);
+        return true;
+    }
+
+    return false;
+}
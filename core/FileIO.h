@@ -0,0 +1,11 @@
+#ifndef MINESWEEPER_FILEIO_H
+#define MINESWEEPER_FILEIO_H
+
+#include "BoardTypes.h"
+
+// returns a new[]'d, null terminated copy of the file or nullptr on failure
+char *loadFile(const char *path);
+
+bool loadConfig(Config *config, const char *filename);
+
+#endif //MINESWEEPER_FILEIO_H
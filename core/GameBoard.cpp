@@ -0,0 +1,315 @@
+#include "GameBoard.h"
+
+#include <cassert>
+#include <utility>
+
+#include "MineSampling.h"
+#include "NeighborKernel.h"
+#include "Rng.h"
+
+GameBoard::GameBoard(const FloatRect &rect, const Config &config, TileStorage storage)
+        : GameBoard(rect, config, randomSeed(), storage) {}
+
+GameBoard::GameBoard(const FloatRect &rect, const Config &config, uint64_t seed, TileStorage storage)
+        : storage(storage), grid(config.rows, config.cols), chunkGrid(config.rows, config.cols),
+          kernels(selectKernels(config, storage)), layout{rect, config.rows, config.cols}, cfg(config),
+          mineCount(0), flagCount(0), hiddenSafeCount(0), seed(0), seeded(false) {
+    // past a quarter of the board a full redraw is cheaper than the list
+    changes.limit = static_cast<size_t>(config.rows)*config.cols/4 + 64;
+    generate(seed);
+}
+
+void GameBoard::resetTiles(NeighborPlaneStore &mines) {
+    Tile sentinel;
+    sentinel.isRevealed = true;
+    sentinel.numNeighbors = -1; // never taken for an opening or a number
+
+    // start from all sentinels, which also covers unused cells at the end of
+    // chunks; nothing ever edits a sentinel, so a board of the right size
+    // already has them and only its cells get rewritten
+    const size_t size = storage == TileStorage::Chunked ? chunkGrid.size() : grid.size();
+    if (tiles.size() != size)
+        tiles.assign(size, sentinel);
+    changes.markFullRefresh();
+
+    computeNeighborBits(mines.planes);
+    kernels->writeTiles(*this, mines.planes);
+}
+
+void GameBoard::flagAllMines() {
+    for (size_t i = 0; i < tiles.size(); ++i) {
+        Tile &tile = tiles[i];
+        if (tile.isFlagged != tile.isMine) {
+            tile.isFlagged = tile.isMine;
+            changes.record(static_cast<int>(i), tile);
+        }
+    }
+    flagCount = mineCount;
+}
+
+void GameBoard::updateParentRect(const FloatRect &rect) {
+    layout.parentRect = rect;
+}
+
+void GameBoard::computeNeighbors()
+{
+    kernels->computeNeighbors(*this);
+}
+
+void GameBoard::generate()
+{
+    generate(randomSeed());
+}
+
+void GameBoard::generate(uint64_t seed)
+{
+    generateAround(seed, nullptr, 0);
+}
+
+void GameBoard::generate(uint64_t seed, Vec2i safeCell)
+{
+    int excluded[9];
+    int excludedCount = 0;
+    for (int y = safeCell.y-1; y <= safeCell.y+1; ++y) {
+        for (int x = safeCell.x-1; x <= safeCell.x+1; ++x) {
+            if (coordsExist({x,y}))
+                excluded[excludedCount++] = layout.tileIndex({x,y}); // row-major, so already sorted
+        }
+    }
+
+    generateAround(seed, excluded, excludedCount);
+}
+
+void GameBoard::generateAround(uint64_t seed, const int *excluded, int excludedCount)
+{
+    mineCount = 0;
+    flagCount = 0;
+    this->seed = seed;
+    seeded = true;
+
+    // sample over the cells that may hold mines, then map back to board cells
+    const int cells = cfg.rows*cfg.cols;
+    Rng rng(seed);
+    std::vector<char> mines;
+    sampleMines(cells-excludedCount, cfg.numMines, [&](int bound) { return static_cast<int>(rng.below(bound)); }, mines);
+
+    // write mines into a bit plane, the tiles are built from it; no branch on
+    // the mines themselves, those would be mispredicted at any density
+    NeighborPlaneStore store(cfg.rows, cfg.cols);
+    int next = 0;
+    for (int y = 0, i = 0, cell = 0; y < cfg.rows; ++y) {
+        uint64_t *row = store.row(y);
+        for (int x = 0; x < cfg.cols; ++x, ++cell) {
+            uint64_t mine = 0;
+            if (next < excludedCount && excluded[next] == cell)
+                ++next;
+            else
+                mine = mines[i++];
+
+            row[x >> 6] |= mine << (x & 63);
+            mineCount += static_cast<int>(mine);
+        }
+    }
+
+    resetTiles(store);
+    hiddenSafeCount = cells - mineCount;
+    if (labelOpenings)
+        regions.build(*this);
+    else
+        regions.valid = false;
+}
+
+void GameBoard::floodFill(Vec2i coords) {
+    floodFillAt(storageIndex(coords));
+}
+
+void GameBoard::floodFillAt(int index) {
+    const Tile &tile = tiles[index];
+    if (!regions.valid || tile.isRevealed || tile.isMine || tile.numNeighbors != 0) {
+        kernels->floodFill(*this, &index, 1);
+        return;
+    }
+
+    // a zero cell: reveal its whole region and border from the lists
+    const int region = regions.label[index];
+    for (int i = regions.cellStart[region]; i < regions.cellStart[region+1]; ++i) {
+        if (!tiles[regions.cells[i]].isRevealed)
+            revealTile(regions.cells[i]);
+    }
+    for (int i = regions.borderStart[region]; i < regions.borderStart[region+1]; ++i) {
+        if (!tiles[regions.border[i]].isRevealed)
+            revealTile(regions.border[i]);
+    }
+}
+
+void GameBoard::floodFillMany(const int *indices, int count) {
+    if (!regions.valid) {
+        kernels->floodFill(*this, indices, count);
+        return;
+    }
+
+    // regions revealed by an earlier index are skipped as already revealed
+    for (int i = 0; i < count; ++i)
+        floodFillAt(indices[i]);
+}
+
+void GameBoard::reveal(Vec2i coords) {
+    const int index = storageIndex(coords);
+    if (!tiles[index].isRevealed && !tiles[index].isMine)
+        revealTile(index);
+}
+
+void GameBoard::loadBoard(char board[]) {
+    mineCount = 0;
+    flagCount = 0;
+    seed = 0;
+    seeded = false;
+
+    NeighborPlaneStore store(cfg.rows, cfg.cols);
+    for (int y = 0; y < cfg.rows; ++y) {
+        for (int x = 0; x < cfg.cols; ++x) {
+            long off1 = y*(cfg.cols+1)+x; // +1 for \n in string
+            if (board[off1] == '1') {
+                store.setMine(x, y);
+                ++mineCount;
+            }
+        }
+    }
+
+    resetTiles(store);
+    hiddenSafeCount = cfg.rows*cfg.cols - mineCount;
+    if (labelOpenings)
+        regions.build(*this);
+    else
+        regions.valid = false;
+}
+
+void GameBoard::toggleFlag(Vec2i coords) {
+    const int index = storageIndex(coords);
+    if (!tiles[index].isRevealed)
+        setFlag(index, !tiles[index].isFlagged);
+}
+
+bool GameBoard::chord(Vec2i coords) {
+    bool hitMine = false;
+    int seeds[8];
+    const int seedCount = chordSeeds(coords, seeds, hitMine);
+    floodFillMany(seeds, seedCount);
+    return hitMine;
+}
+
+int GameBoard::chordSeeds(Vec2i coords, int seeds[8], bool &hitMine) const {
+    hitMine = false;
+    const int index = storageIndex(coords);
+    const Tile &tile = tiles[index];
+    if (!tile.isRevealed || tile.numNeighbors <= 0)
+        return 0;
+
+    int hidden[8];
+    int hiddenCount = 0;
+    int flags = 0;
+    for (int k = 0; k < 8; ++k) {
+        const int neighbor = neighborIndex(index, k);
+        if (tiles[neighbor].isFlagged)
+            flags++;
+        else if (!tiles[neighbor].isRevealed)
+            hidden[hiddenCount++] = neighbor;
+    }
+    if (flags != tile.numNeighbors)
+        return 0;
+
+    int seedCount = 0;
+    for (int i = 0; i < hiddenCount; ++i) {
+        if (tiles[hidden[i]].isMine)
+            hitMine = true;
+        else
+            seeds[seedCount++] = hidden[i];
+    }
+    return seedCount;
+}
+
+bool GameBoard::addMine(Vec2i coords) {
+    const int index = storageIndex(coords);
+    Tile &tile = tiles[index];
+    if (tile.isMine || tile.isRevealed)
+        return false;
+
+    tile.isMine = true;
+    tile.numNeighbors = 0;
+    changes.record(index, tile);
+    for (int k = 0; k < 8; ++k) {
+        const int neighborAt = neighborIndex(index, k);
+        Tile &neighbor = tiles[neighborAt];
+        if (!neighbor.isMine && neighbor.numNeighbors >= 0) { // skip sentinels
+            neighbor.numNeighbors++;
+            changes.record(neighborAt, neighbor);
+        }
+    }
+
+    mineCount++;
+    hiddenSafeCount--;
+    regions.valid = false;
+    seeded = false;
+    return true;
+}
+
+bool GameBoard::removeMine(Vec2i coords) {
+    const int index = storageIndex(coords);
+    Tile &tile = tiles[index];
+    if (!tile.isMine)
+        return false;
+
+    tile.isMine = false;
+    int count = 0;
+    for (int k = 0; k < 8; ++k) {
+        const int neighborAt = neighborIndex(index, k);
+        Tile &neighbor = tiles[neighborAt];
+        if (neighbor.isMine) {
+            count++;
+        } else if (neighbor.numNeighbors >= 0) {
+            neighbor.numNeighbors--;
+            changes.record(neighborAt, neighbor);
+        }
+    }
+    tile.numNeighbors = count;
+    changes.record(index, tile);
+
+    mineCount--;
+    hiddenSafeCount++;
+    regions.valid = false;
+    seeded = false;
+    return true;
+}
+
+bool GameBoard::moveMine(Vec2i from, Vec2i to) {
+    const Tile &target = accessTile(to);
+    if (!accessTile(from).isMine || target.isMine || target.isRevealed)
+        return false;
+
+    removeMine(from);
+    addMine(to);
+    return true;
+}
+
+void GameBoard::swapState(GameBoard &other) {
+    assert(storage == other.storage && cfg.rows == other.cfg.rows && cfg.cols == other.cfg.cols);
+    std::swap(tiles, other.tiles);
+    std::swap(mineCount, other.mineCount);
+    std::swap(flagCount, other.flagCount);
+    std::swap(hiddenSafeCount, other.hiddenSafeCount);
+    std::swap(seed, other.seed);
+    std::swap(seeded, other.seeded);
+    std::swap(regions, other.regions); // labels belong to the tiles
+    changes.markFullRefresh();
+    other.changes.markFullRefresh();
+}
+
+bool GameBoard::mouseOverTile(Vec2i &tileCoords, const Vec2f &mousePos) const {
+    return layout.tileAt(mousePos, tileCoords);
+}
+
+int GameBoard::openingCount() {
+    if (!regions.valid)
+        regions.build(*this);
+    return regions.count();
+}
@@ -0,0 +1,145 @@
+#ifndef MINESWEEPER_GAMEBOARD_H
+#define MINESWEEPER_GAMEBOARD_H
+
+#include <cstdint>
+#include <vector>
+
+#include "BoardGrid.h"
+#include "BoardKernels.h"
+#include "BoardLayout.h"
+#include "BoardTypes.h"
+#include "ChangeList.h"
+#include "ZeroRegions.h"
+
+struct NeighborPlaneStore;
+
+// Tiles are stored with a one-cell sentinel ring around the board, either
+// row-major (`grid`) or in 64x64 chunks (`chunkGrid`). Sentinels are revealed
+// non-mines with numNeighbors -1, so neighbor loops can step to the 8
+// neighbors without checking board edges.
+struct GameBoard {
+    std::vector<Tile> tiles;
+    TileStorage storage;
+    DynamicGrid grid;
+    ChunkedGrid chunkGrid;
+    const BoardKernels *kernels; // picked from cfg, specialized for preset sizes
+    BoardLayout layout;
+    Config cfg;
+    int mineCount;
+    int flagCount;
+    int hiddenSafeCount; // unrevealed non-mine cells, the game is won at 0
+    uint64_t seed;       // seed of the last generate(), log it to replay a board
+    bool seeded;         // false after loadBoard() or a mine edit, seed then replays nothing
+    std::vector<int> fillStack; // reusable work buffer for floodFill
+    ZeroRegions regions;        // openings labelled by generate()/loadBoard()
+    ChangeList changes;         // every tile edit, for renderers/sync to consume
+    bool labelOpenings = true;  // off for throwaway boards, floodFill then uses the kernel
+
+    GameBoard(const FloatRect &rect, const Config &config, TileStorage storage = TileStorage::RowMajor);
+    // starts out as generate(seed), for owners that would regenerate right away
+    GameBoard(const FloatRect &rect, const Config &config, uint64_t seed, TileStorage storage = TileStorage::RowMajor);
+
+    void flagAllMines();
+    void updateParentRect(const FloatRect &rect);
+    void computeNeighbors();
+    // same seed and config always give the same board
+    void generate(uint64_t seed);
+    // generates from a fresh random seed
+    void generate();
+    // keeps safeCell and its neighbors mine free, so a first click there opens
+    void generate(uint64_t seed, Vec2i safeCell);
+    void floodFill(Vec2i coords);
+    // same as floodFill() for a storage index; openings come from `regions`
+    // while they're valid, otherwise from the flood kernel
+    void floodFillAt(int index);
+    // floodFillAt() for several storage indices, filling shared openings once
+    void floodFillMany(const int *indices, int count);
+    // reveals a single non-mine cell without flooding
+    void reveal(Vec2i coords);
+    void loadBoard(char board[]);
+    // flags or unflags a hidden tile
+    void toggleFlag(Vec2i coords);
+    // Chord on a revealed number: when its flagged neighbors match the number,
+    // reveals all other hidden neighbors at once. Returns true if one of those
+    // was a mine (a wrong flag), which is left hidden for the caller to handle.
+    bool chord(Vec2i coords);
+    // the storage indices chord() would flood, for callers that reveal them
+    // over several frames; returns their count and sets hitMine like chord()
+    int chordSeeds(Vec2i coords, int seeds[8], bool &hitMine) const;
+    // single mine edits that only update the 3x3 neighborhood counts and the
+    // mine/win counters, each returns false if the edit isn't allowed
+    bool addMine(Vec2i coords);    // needs a hidden non-mine cell
+    bool removeMine(Vec2i coords); // needs a mine
+    bool moveMine(Vec2i from, Vec2i to);
+
+    // exchanges tiles and counters with a board of the same Config and
+    // TileStorage (the tiles are laid out by both), layout stays
+    void swapState(GameBoard &other);
+    // constant time, cheap enough for a hover check every frame
+    bool mouseOverTile(Vec2i &tileCoords, const Vec2f &mousePos) const;
+    // number of openings, relabels first if mine edits made the labels stale
+    int openingCount();
+
+    // all unrevealed cells are mines
+    bool areWeWinners() const {
+        return hiddenSafeCount == 0;
+    }
+
+    Tile &accessTile(Vec2i coords) {
+        return tiles[storageIndex(coords)];
+    }
+
+    // storage index of the k-th neighbor (see BoardGrid.h for the order)
+    int neighborIndex(int index, int k) const {
+        if (storage == TileStorage::Chunked)
+            return chunkGrid.neighbor(index, k);
+        return grid.neighbor(index, k);
+    }
+
+    int storageIndex(Vec2i coords) const {
+        if (storage == TileStorage::Chunked)
+            return chunkGrid.index(coords.x, coords.y);
+        return grid.index(coords.x, coords.y);
+    }
+
+    // board coordinates of a storage index, the inverse of storageIndex()
+    Vec2i tileCoords(int index) const {
+        if (storage == TileStorage::Chunked)
+            return chunkGrid.coords(index);
+        return grid.coords(index);
+    }
+
+    // marks a hidden non-mine tile revealed and keeps the counters in sync
+    void revealTile(int index) {
+        Tile &tile = tiles[index];
+        tile.isRevealed = true;
+        hiddenSafeCount--;
+        if (tile.isFlagged) {
+            flagCount--;
+            tile.isFlagged = false;
+        }
+        changes.record(index, tile);
+    }
+
+    void setFlag(int index, bool flagged) {
+        Tile &tile = tiles[index];
+        if (tile.isFlagged == flagged)
+            return;
+        tile.isFlagged = flagged;
+        flagCount += flagged ? 1 : -1;
+        changes.record(index, tile);
+    }
+
+    bool coordsExist(Vec2i coords) {
+        return coords.x >= 0 && coords.x < cfg.cols && coords.y >= 0 && coords.y < cfg.rows;
+    }
+
+private:
+    // rebuilds the sentinel ring and every board cell as a hidden tile, with
+    // the mines of `mines` and their neighbor counts
+    void resetTiles(NeighborPlaneStore &mines);
+    // `excluded` are sorted row-major cell indices that stay mine free
+    void generateAround(uint64_t seed, const int *excluded, int excludedCount);
+};
+
+#endif //MINESWEEPER_GAMEBOARD_H
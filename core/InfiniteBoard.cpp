@@ -0,0 +1,156 @@
+#include "InfiniteBoard.h"
+
+#include <cmath>
+
+#include "Rng.h"
+
+InfiniteBoard::InfiniteBoard(uint64_t seed, double mineDensity, int evictRadius, int maxRevealCells)
+        : seed(seed), evictRadius(evictRadius), maxRevealCells(maxRevealCells), flagCount(0), revealedCount(0) {
+    if (mineDensity <= 0.0)
+        mineThreshold = 0;
+    else if (mineDensity >= 1.0)
+        mineThreshold = ~uint64_t(0);
+    else
+        mineThreshold = static_cast<uint64_t>(std::ldexp(mineDensity, 64));
+}
+
+bool InfiniteBoard::isMine(Vec2i coords) const {
+    const uint64_t cell = chunkKey(coords.x, coords.y);
+    return splitmix64(seed ^ splitmix64(cell)) < mineThreshold;
+}
+
+InfiniteBoard::Chunk &InfiniteBoard::chunkAt(int cx, int cy) {
+    auto found = chunks.find(chunkKey(cx, cy));
+    if (found != chunks.end())
+        return found->second;
+
+    Chunk &chunk = chunks[chunkKey(cx, cy)];
+    chunk.tiles.resize(chunkSize*chunkSize);
+    chunk.revealedCount = 0;
+    chunk.flaggedCount = 0;
+
+    const int originX = cx << chunkShift;
+    const int originY = cy << chunkShift;
+    for (int ly = 0; ly < chunkSize; ++ly) {
+        for (int lx = 0; lx < chunkSize; ++lx) {
+            const int x = originX + lx;
+            const int y = originY + ly;
+
+            Tile &tile = chunk.tiles[(ly << chunkShift) + lx];
+            tile.isMine = isMine({x,y});
+            if (!tile.isMine) {
+                tile.numNeighbors = isMine({x-1,y-1}) + isMine({x,y-1}) + isMine({x+1,y-1}) +
+                                    isMine({x-1,y  }) +                   isMine({x+1,y  }) +
+                                    isMine({x-1,y+1}) + isMine({x,y+1}) + isMine({x+1,y+1});
+            }
+        }
+    }
+
+    return chunk;
+}
+
+Tile &InfiniteBoard::accessTile(Vec2i coords) {
+    // arithmetic shift and mask give floor division for negative coordinates too
+    Chunk &chunk = chunkAt(coords.x >> chunkShift, coords.y >> chunkShift);
+    return chunk.tiles[((coords.y & chunkMask) << chunkShift) + (coords.x & chunkMask)];
+}
+
+void InfiniteBoard::revealTile(Vec2i coords, Tile &tile) {
+    Chunk &chunk = chunkAt(coords.x >> chunkShift, coords.y >> chunkShift);
+
+    tile.isRevealed = true;
+    chunk.revealedCount++;
+    revealedCount++;
+
+    if (tile.isFlagged) {
+        tile.isFlagged = false;
+        chunk.flaggedCount--;
+        flagCount--;
+    }
+}
+
+void InfiniteBoard::pushNeighbors(Vec2i coords) {
+    for (int dy = -1; dy <= 1; ++dy) {
+        for (int dx = -1; dx <= 1; ++dx) {
+            if (dx || dy)
+                fillStack.push_back({coords.x+dx, coords.y+dy});
+        }
+    }
+}
+
+void InfiniteBoard::fill() {
+    int revealedHere = 0;
+    while (!fillStack.empty() && revealedHere < maxRevealCells) {
+        const Vec2i pos = fillStack.back();
+        fillStack.pop_back();
+
+        Tile &tile = accessTile(pos);
+        if (tile.isRevealed || tile.isMine)
+            continue;
+
+        revealTile(pos, tile);
+        revealedHere++;
+
+        if (tile.numNeighbors == 0)
+            pushNeighbors(pos);
+    }
+
+    evictDistantChunks();
+}
+
+bool InfiniteBoard::reveal(Vec2i coords) {
+    Tile &clicked = accessTile(coords);
+    if (clicked.isMine)
+        return false;
+
+    // a revealed zero can border cells an earlier capped fill hasn't reached yet
+    if (clicked.isRevealed && clicked.numNeighbors == 0)
+        pushNeighbors(coords);
+    else
+        fillStack.push_back(coords);
+
+    fill();
+    return true;
+}
+
+bool InfiniteBoard::step() {
+    fill();
+    return fillStack.empty();
+}
+
+void InfiniteBoard::toggleFlag(Vec2i coords) {
+    Tile &tile = accessTile(coords);
+    if (tile.isRevealed)
+        return;
+
+    Chunk &chunk = chunkAt(coords.x >> chunkShift, coords.y >> chunkShift);
+    const int delta = tile.isFlagged ? -1 : 1;
+    tile.isFlagged = !tile.isFlagged;
+    chunk.flaggedCount += delta;
+    flagCount += delta;
+}
+
+void InfiniteBoard::evictDistantChunks() {
+    for (auto it = chunks.begin(); it != chunks.end();) {
+        if (it->second.hasPlayerState()) {
+            ++it;
+            continue;
+        }
+
+        const int cx = static_cast<int32_t>(it->first >> 32);
+        const int cy = static_cast<int32_t>(it->first & 0xffffffffu);
+
+        bool nearPlayer = false;
+        for (int dy = -evictRadius; dy <= evictRadius && !nearPlayer; ++dy) {
+            for (int dx = -evictRadius; dx <= evictRadius && !nearPlayer; ++dx) {
+                auto neighbor = chunks.find(chunkKey(cx+dx, cy+dy));
+                nearPlayer = neighbor != chunks.end() && neighbor->second.hasPlayerState();
+            }
+        }
+
+        if (nearPlayer)
+            ++it;
+        else
+            it = chunks.erase(it);
+    }
+}
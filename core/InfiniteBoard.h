@@ -0,0 +1,74 @@
+#ifndef MINESWEEPER_INFINITEBOARD_H
+#define MINESWEEPER_INFINITEBOARD_H
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "BoardTypes.h"
+
+// Unbounded board for the endless mode. Whether a cell is a mine is a pure
+// function of the seed and the cell coordinates, so 64x64 chunks of tiles are
+// only created when first touched and chunks without any player state can be
+// dropped and recreated identically later. Memory follows what the player has
+// explored, not the size of the board.
+struct InfiniteBoard {
+    static const int chunkShift = 6;
+    static const int chunkSize = 1 << chunkShift;
+    static const int chunkMask = chunkSize-1;
+
+    struct Chunk {
+        std::vector<Tile> tiles;
+        int revealedCount;
+        int flaggedCount;
+
+        bool hasPlayerState() const { return revealedCount > 0 || flaggedCount > 0; }
+    };
+
+    uint64_t seed;
+    uint64_t mineThreshold; // cell is a mine when its hash is below this
+    int evictRadius;        // in chunks, around chunks with player state
+    int maxRevealCells;     // caps one reveal()/step(), sparse boards can have unbounded openings
+
+    std::unordered_map<uint64_t, Chunk> chunks;
+    int flagCount;
+    long revealedCount;
+
+    InfiniteBoard(uint64_t seed, double mineDensity, int evictRadius = 2, int maxRevealCells = 1 << 20);
+
+    bool isMine(Vec2i coords) const;
+
+    // creates the owning chunk on first touch
+    Tile &accessTile(Vec2i coords);
+
+    // reveals like GameBoard::floodFill, returns false if the cell is a mine;
+    // an opening past maxRevealCells stays pending for step() or the next
+    // reveal(), and clicking a revealed zero opens its hidden neighbors
+    bool reveal(Vec2i coords);
+    // continues a pending opening, returns true once none is left
+    bool step();
+    bool revealPending() const { return !fillStack.empty(); }
+    void toggleFlag(Vec2i coords);
+
+    // drops chunks without player state that are farther than evictRadius
+    // chunks from every chunk the player has revealed or flagged in
+    void evictDistantChunks();
+
+    size_t chunkCount() const { return chunks.size(); }
+
+private:
+    std::vector<Vec2i> fillStack; // kept between calls, the frontier of a capped opening
+
+    static uint64_t chunkKey(int cx, int cy) {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(cx)) << 32) | static_cast<uint32_t>(cy);
+    }
+
+    Chunk &chunkAt(int cx, int cy);
+    void revealTile(Vec2i coords, Tile &tile);
+    void pushNeighbors(Vec2i coords);
+    // reveals from fillStack until it's empty or maxRevealCells were revealed
+    void fill();
+};
+
+#endif //MINESWEEPER_INFINITEBOARD_H
@@ -0,0 +1,32 @@
+#ifndef MINESWEEPER_MINESAMPLING_H
+#define MINESWEEPER_MINESAMPLING_H
+
+#include <vector>
+
+// Marks `mines` distinct cells out of `cells` (row-major cell indices) in
+// `marks`, using Floyd's sampling: one random draw per sampled cell and no
+// retries, so the cost is O(cells) for clearing plus O(min(mines, safe)).
+// When more than half the board is mines the safe cells are sampled instead.
+//
+// `randomBelow(n)` must return a uniform integer in [0, n).
+template <class RandomBelow>
+void sampleMines(int cells, int mines, RandomBelow &&randomBelow, std::vector<char> &marks) {
+    if (mines > cells)
+        mines = cells;
+
+    const bool sampleSafe = mines > cells/2;
+    const int count = sampleSafe ? cells-mines : mines;
+
+    marks.assign(cells, sampleSafe ? 1 : 0);
+    const char picked = sampleSafe ? 0 : 1;
+
+    for (int j = cells-count; j < cells; ++j) {
+        const int t = randomBelow(j+1);
+        if (marks[t] == picked)
+            marks[j] = picked;
+        else
+            marks[t] = picked;
+    }
+}
+
+#endif //MINESWEEPER_MINESAMPLING_H
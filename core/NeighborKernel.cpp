@@ -0,0 +1,187 @@
+#include "NeighborKernel.h"
+
+#include "BitBoard.h"
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define MINESWEEPER_HAVE_AVX2_KERNEL 1
+#include <immintrin.h>
+#endif
+
+namespace {
+
+// sum of 8 one-bit inputs per bit position, as 4 bit-sliced output bits
+typedef uint64_t Word;
+
+inline void addNeighbors(Word upW, Word up, Word upE, Word w, Word e, Word downW, Word down, Word downE,
+                         Word &bit0, Word &bit1, Word &bit2, Word &bit3) {
+    // full adders over the row above and below, half adder over the middle row
+    const Word upSum = upW ^ up ^ upE;
+    const Word upCarry = (upW & up) | (upE & (upW ^ up));
+    const Word downSum = downW ^ down ^ downE;
+    const Word downCarry = (downW & down) | (downE & (downW ^ down));
+    const Word midSum = w ^ e;
+    const Word midCarry = w & e;
+
+    // weight 1
+    bit0 = upSum ^ downSum ^ midSum;
+    const Word onesCarry = (upSum & downSum) | (midSum & (upSum ^ downSum));
+
+    // weight 2: upCarry + downCarry + midCarry + onesCarry
+    const Word twosSum = upCarry ^ downCarry ^ midCarry;
+    const Word twosCarry = (upCarry & downCarry) | (midCarry & (upCarry ^ downCarry));
+    bit1 = twosSum ^ onesCarry;
+    const Word twosCarry2 = twosSum & onesCarry;
+
+    // weight 4 and 8
+    bit2 = twosCarry ^ twosCarry2;
+    bit3 = twosCarry & twosCarry2;
+}
+
+// valid cell bits of word w (1-based, guards excluded) in a row
+inline uint64_t cellMask(const NeighborPlanes &planes, int w) {
+    const int cellsInWord = planes.cols - (w-1)*64;
+    return cellsInWord >= 64 ? ~uint64_t(0) : (uint64_t(1) << cellsInWord) - 1;
+}
+
+void countWord(const NeighborPlanes &planes, int index, int w) {
+    const uint64_t *mines = planes.mines;
+    const int stride = planes.stride;
+
+    const uint64_t *up = mines + index - stride;
+    const uint64_t *mid = mines + index;
+    const uint64_t *down = mines + index + stride;
+
+    // west neighbor of cell x is cell x-1, so shift towards higher bits; guard words cover the row ends
+    uint64_t bit0, bit1, bit2, bit3;
+    addNeighbors((up[0] << 1) | (up[-1] >> 63), up[0], (up[0] >> 1) | (up[1] << 63),
+                 (mid[0] << 1) | (mid[-1] >> 63), (mid[0] >> 1) | (mid[1] << 63),
+                 (down[0] << 1) | (down[-1] >> 63), down[0], (down[0] >> 1) | (down[1] << 63),
+                 bit0, bit1, bit2, bit3);
+
+    // mines keep a count of 0, and padding bits past the last column stay clear
+    const uint64_t keep = ~mid[0] & cellMask(planes, w);
+    planes.counts[0][index] = bit0 & keep;
+    planes.counts[1][index] = bit1 & keep;
+    planes.counts[2][index] = bit2 & keep;
+    planes.counts[3][index] = bit3 & keep;
+}
+
+#ifdef MINESWEEPER_HAVE_AVX2_KERNEL
+
+__attribute__((target("avx2")))
+void computeNeighborBitsAvx2(const NeighborPlanes &planes) {
+    const int stride = planes.stride;
+    const uint64_t *mines = planes.mines;
+    const __m256i allOnes = _mm256_set1_epi64x(-1);
+
+    for (int y = 0; y < planes.rows; ++y) {
+        const int rowStart = (y+1)*stride;
+        int w = 1;
+
+        // full words only, the last (possibly partial) words go through countWord
+        for (; w+4 <= planes.wordsPerRow; w += 4) {
+            const int index = rowStart + w;
+            __m256i in[3][3]; // [row][west, center, east]
+            for (int r = 0; r < 3; ++r) {
+                const uint64_t *p = mines + index + (r-1)*stride;
+                const __m256i center = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+                const __m256i prev = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p-1));
+                const __m256i next = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p+1));
+                in[r][0] = _mm256_or_si256(_mm256_slli_epi64(center, 1), _mm256_srli_epi64(prev, 63));
+                in[r][1] = center;
+                in[r][2] = _mm256_or_si256(_mm256_srli_epi64(center, 1), _mm256_slli_epi64(next, 63));
+            }
+
+            // same adder network as addNeighbors, spelled out for __m256i
+            const __m256i upSum = _mm256_xor_si256(_mm256_xor_si256(in[0][0], in[0][1]), in[0][2]);
+            const __m256i upCarry = _mm256_or_si256(_mm256_and_si256(in[0][0], in[0][1]),
+                                                    _mm256_and_si256(in[0][2], _mm256_xor_si256(in[0][0], in[0][1])));
+            const __m256i downSum = _mm256_xor_si256(_mm256_xor_si256(in[2][0], in[2][1]), in[2][2]);
+            const __m256i downCarry = _mm256_or_si256(_mm256_and_si256(in[2][0], in[2][1]),
+                                                      _mm256_and_si256(in[2][2], _mm256_xor_si256(in[2][0], in[2][1])));
+            const __m256i midSum = _mm256_xor_si256(in[1][0], in[1][2]);
+            const __m256i midCarry = _mm256_and_si256(in[1][0], in[1][2]);
+
+            const __m256i bit0 = _mm256_xor_si256(_mm256_xor_si256(upSum, downSum), midSum);
+            const __m256i onesCarry = _mm256_or_si256(_mm256_and_si256(upSum, downSum),
+                                                      _mm256_and_si256(midSum, _mm256_xor_si256(upSum, downSum)));
+            const __m256i twosSum = _mm256_xor_si256(_mm256_xor_si256(upCarry, downCarry), midCarry);
+            const __m256i twosCarry = _mm256_or_si256(_mm256_and_si256(upCarry, downCarry),
+                                                      _mm256_and_si256(midCarry, _mm256_xor_si256(upCarry, downCarry)));
+            const __m256i bit1 = _mm256_xor_si256(twosSum, onesCarry);
+            const __m256i twosCarry2 = _mm256_and_si256(twosSum, onesCarry);
+            const __m256i bit2 = _mm256_xor_si256(twosCarry, twosCarry2);
+            const __m256i bit3 = _mm256_and_si256(twosCarry, twosCarry2);
+
+            const __m256i keep = _mm256_xor_si256(in[1][1], allOnes);
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(&planes.counts[0][index]), _mm256_and_si256(bit0, keep));
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(&planes.counts[1][index]), _mm256_and_si256(bit1, keep));
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(&planes.counts[2][index]), _mm256_and_si256(bit2, keep));
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(&planes.counts[3][index]), _mm256_and_si256(bit3, keep));
+        }
+
+        for (; w <= planes.wordsPerRow; ++w)
+            countWord(planes, rowStart + w, w);
+    }
+}
+
+bool cpuHasAvx2() {
+    static const bool hasAvx2 = __builtin_cpu_supports("avx2") != 0;
+    return hasAvx2;
+}
+
+#endif
+
+NeighborPlanes planesOf(BitBoard &board) {
+    NeighborPlanes planes;
+    planes.mines = board.mines.data();
+    for (int i = 0; i < 4; ++i)
+        planes.counts[i] = board.neighborBits[i].data();
+    planes.rows = board.cfg.rows;
+    planes.cols = board.cfg.cols;
+    planes.wordsPerRow = board.wordsPerRow;
+    planes.stride = board.stride;
+    return planes;
+}
+
+}
+
+NeighborPlaneStore::NeighborPlaneStore(int rows, int cols) {
+    planes.rows = rows;
+    planes.cols = cols;
+    planes.wordsPerRow = (cols + 63) >> 6;
+    planes.stride = planes.wordsPerRow + 2;
+
+    // mine plane first, then the count planes
+    const size_t planeWords = static_cast<size_t>(planes.stride)*(rows+2);
+    words.assign(planeWords*5, 0);
+    planes.mines = words.data();
+    for (int i = 0; i < 4; ++i)
+        planes.counts[i] = words.data() + planeWords*(i+1);
+}
+
+void computeNeighborBitsScalar(const NeighborPlanes &planes) {
+    for (int y = 0; y < planes.rows; ++y) {
+        const int rowStart = (y+1)*planes.stride;
+        for (int w = 1; w <= planes.wordsPerRow; ++w)
+            countWord(planes, rowStart + w, w);
+    }
+}
+
+void computeNeighborBits(const NeighborPlanes &planes) {
+#ifdef MINESWEEPER_HAVE_AVX2_KERNEL
+    if (cpuHasAvx2()) {
+        computeNeighborBitsAvx2(planes);
+        return;
+    }
+#endif
+    computeNeighborBitsScalar(planes);
+}
+
+void computeNeighborBitsScalar(BitBoard &board) {
+    computeNeighborBitsScalar(planesOf(board));
+}
+
+void computeNeighborBits(BitBoard &board) {
+    computeNeighborBits(planesOf(board));
+}
@@ -0,0 +1,53 @@
+#ifndef MINESWEEPER_NEIGHBORKERNEL_H
+#define MINESWEEPER_NEIGHBORKERNEL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+struct BitBoard;
+
+// Bit planes in BitBoard's layout: `rows` rows of `stride` words, a guard word
+// on both sides of each row and a guard row above and below, all zero in
+// `mines`. Cell (x, y) is bit x&63 of word (y+1)*stride + 1 + (x>>6).
+struct NeighborPlanes {
+    const uint64_t *mines;
+    uint64_t *counts[4]; // bit i of each cell's neighbor count, 0 for mines
+    int rows, cols;
+    int wordsPerRow;
+    int stride; // wordsPerRow + 2
+};
+
+// Owns the mine plane and the 4 count planes of a rows x cols board, for
+// callers that don't keep bit planes themselves. Starts without mines.
+struct NeighborPlaneStore {
+    std::vector<uint64_t> words;
+    NeighborPlanes planes;
+
+    NeighborPlaneStore(int rows, int cols);
+
+    // the mine words of board row y
+    uint64_t *row(int y) {
+        return words.data() + (y+1)*planes.stride + 1;
+    }
+
+    void setMine(int x, int y) {
+        row(y)[x >> 6] |= uint64_t(1) << (x & 63);
+    }
+};
+
+// Fills the count planes from the mine plane, 64 cells per word: each row's
+// 8 neighbor planes (row above/below and the west/east shifted words) are
+// summed with bit-sliced full adders straight into the 4 count planes. Picks
+// an AVX2 version (4 words per instruction) at runtime when the CPU has it.
+// Guard words of the count planes are left untouched.
+void computeNeighborBits(const NeighborPlanes &planes);
+
+// the portable version, exposed so both paths can be compared
+void computeNeighborBitsScalar(const NeighborPlanes &planes);
+
+// the same for a BitBoard, rebuilding board.neighborBits from board.mines
+void computeNeighborBits(BitBoard &board);
+void computeNeighborBitsScalar(BitBoard &board);
+
+#endif //MINESWEEPER_NEIGHBORKERNEL_H
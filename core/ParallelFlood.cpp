@@ -0,0 +1,263 @@
+#include "ParallelFlood.h"
+
+#include "GameBoard.h"
+#include "ThreadPool.h"
+
+namespace {
+
+const int chunkShift = 6;
+const int chunkSize = 1 << chunkShift;
+const size_t minParallelCells = size_t(1) << 18; // below this the serial fill wins
+
+}
+
+ParallelFlood::ParallelFlood(ThreadPool &pool) : pool(pool), chunksX(0), recordChanges(true) {}
+
+bool ParallelFlood::handles(const GameBoard &board, Vec2i coords) const {
+    const int seed = board.storageIndex(coords);
+    const Tile &tile = board.tiles[seed];
+    if (tile.isRevealed || tile.isMine || tile.numNeighbors != 0 || pool.size() == 1)
+        return false;
+
+    // stale labels don't tell the opening's size, so go by the board's
+    const ZeroRegions &regions = board.regions;
+    if (!regions.valid)
+        return board.tiles.size() >= minParallelCells;
+
+    const int region = regions.label[seed];
+    const size_t listed = regions.cellStart[region+1] - regions.cellStart[region] +
+                          regions.borderStart[region+1] - regions.borderStart[region];
+    return listed >= minParallelCells;
+}
+
+void ParallelFlood::floodFill(GameBoard &board, Vec2i coords) {
+    const int seed = board.storageIndex(coords);
+    if (!handles(board, coords)) {
+        board.floodFillAt(seed);
+        return;
+    }
+
+    if (board.regions.valid)
+        revealRegion(board, board.regions.label[seed]);
+    else
+        fillChunks(board, coords.y*board.cfg.cols + coords.x);
+}
+
+void ParallelFlood::revealRegion(GameBoard &board, int region) {
+    const ZeroRegions &regions = board.regions;
+    const int *cells = &regions.cells[regions.cellStart[region]];
+    const int *border = &regions.border[regions.borderStart[region]];
+    const size_t cellCount = regions.cellStart[region+1] - regions.cellStart[region];
+    const size_t listed = cellCount + regions.borderStart[region+1] - regions.borderStart[region];
+
+    // a few blocks per thread to balance, each walks its slice of cells then border
+    blocks.resize(pool.size()*4);
+    const size_t perBlock = (listed + blocks.size()-1) / blocks.size();
+
+    // an opening longer than the change list can only end in a full refresh
+    recordChanges = !board.changes.fullRefresh && listed <= board.changes.limit;
+
+    Tile *tiles = board.tiles.data();
+    pool.parallelFor(blocks.size(), 1, [&](size_t begin, size_t end) {
+        for (size_t b = begin; b < end; ++b) {
+            Block &block = blocks[b];
+            const size_t last = (b+1)*perBlock < listed ? (b+1)*perBlock : listed;
+            for (size_t i = b*perBlock; i < last; ++i) {
+                const int index = i < cellCount ? cells[i] : border[i-cellCount];
+                Tile &tile = tiles[index];
+                if (tile.isRevealed)
+                    continue;
+
+                tile.isRevealed = true;
+                block.revealedCount++;
+                if (tile.isFlagged) {
+                    tile.isFlagged = false;
+                    block.flagsCleared++;
+                }
+                if (recordChanges)
+                    block.revealed.push_back(index);
+            }
+        }
+    });
+
+    // blocks are in list order, so the changes come out as the serial reveal records them
+    size_t revealed = 0;
+    for (const Block &block : blocks)
+        revealed += block.revealedCount;
+    if (board.changes.entries.size() + revealed > board.changes.limit)
+        recordChanges = false;
+    if (!recordChanges && revealed > 0)
+        board.changes.markFullRefresh();
+
+    for (Block &block : blocks) {
+        board.hiddenSafeCount -= block.revealedCount;
+        board.flagCount -= block.flagsCleared;
+        if (recordChanges) {
+            for (int cell : block.revealed)
+                board.changes.record(cell, tiles[cell]);
+        }
+
+        block.revealed.clear();
+        block.revealedCount = 0;
+        block.flagsCleared = 0;
+    }
+}
+
+void ParallelFlood::fillChunks(GameBoard &board, int seed) {
+    const Config &cfg = board.cfg;
+    chunksX = (cfg.cols + chunkSize-1) >> chunkShift;
+    const size_t chunkCount = static_cast<size_t>(chunksX) * ((cfg.rows + chunkSize-1) >> chunkShift);
+    if (chunks.size() != chunkCount)
+        chunks.assign(chunkCount, Chunk());
+
+    recordChanges = !board.changes.fullRefresh;
+    size_t recorded = 0;
+
+    const int first = ((seed / cfg.cols) >> chunkShift)*chunksX + ((seed % cfg.cols) >> chunkShift);
+    chunks[first].seeds.push_back(seed);
+    active.assign(1, first);
+    touched.assign(1, first);
+    chunks[first].touched = true;
+
+    while (!active.empty()) {
+        pool.parallelFor(active.size(), 1, [this, &board](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i)
+                fillChunk(board, active[i]);
+        });
+
+        // hand cells that crossed a chunk edge to their chunk for the next round
+        nextActive.clear();
+        for (int from : active) {
+            Chunk &chunk = chunks[from];
+            for (int cell : chunk.outbox) {
+                const int to = ((cell / cfg.cols) >> chunkShift)*chunksX + ((cell % cfg.cols) >> chunkShift);
+                Chunk &target = chunks[to];
+                target.seeds.push_back(cell);
+                if (!target.active) {
+                    target.active = true;
+                    nextActive.push_back(to);
+                }
+                if (!target.touched) {
+                    target.touched = true;
+                    touched.push_back(to);
+                }
+            }
+            chunk.outbox.clear();
+            recorded += chunk.revealed.size();
+        }
+        for (int to : nextActive)
+            chunks[to].active = false;
+        active.swap(nextActive);
+
+        // past the change list's limit it is going to fall back to a full refresh anyway
+        if (recordChanges && recorded >= board.changes.limit)
+            recordChanges = false;
+    }
+
+    finish(board);
+}
+
+void ParallelFlood::fillChunk(GameBoard &board, int chunkIndex) {
+    const Config &cfg = board.cfg;
+    Chunk &chunk = chunks[chunkIndex];
+    Tile *tiles = board.tiles.data();
+
+    const int x0 = (chunkIndex % chunksX) << chunkShift;
+    const int y0 = (chunkIndex / chunksX) << chunkShift;
+    const int x1 = x0+chunkSize < cfg.cols ? x0+chunkSize : cfg.cols;
+    const int y1 = y0+chunkSize < cfg.rows ? y0+chunkSize : cfg.rows;
+
+    auto reveal = [&](int index) {
+        Tile &tile = tiles[index];
+        tile.isRevealed = true;
+        chunk.revealedCount++;
+        if (tile.isFlagged) {
+            tile.isFlagged = false;
+            chunk.flagsCleared++;
+        }
+        if (recordChanges)
+            chunk.revealed.push_back(index);
+    };
+    auto hiddenZero = [&](int x, int y) {
+        const Tile &tile = tiles[board.storageIndex({x,y})];
+        return !tile.isRevealed && tile.numNeighbors == 0;
+    };
+    auto inChunk = [&](int x, int y) {
+        return x >= x0 && x < x1 && y >= y0 && y < y1;
+    };
+
+    // the same scanline idea as the serial kernel, clipped to the chunk; only
+    // the first seed of the whole fill can be a mine and that was checked
+    while (!chunk.seeds.empty()) {
+        const int cell = chunk.seeds.back();
+        chunk.seeds.pop_back();
+        const int x = cell % cfg.cols;
+        const int y = cell / cfg.cols;
+        const int index = board.storageIndex({x,y});
+        if (tiles[index].isRevealed)
+            continue;
+        if (tiles[index].numNeighbors != 0) {
+            reveal(index);
+            continue;
+        }
+
+        int left = x, right = x;
+        while (left > x0 && hiddenZero(left-1, y))
+            --left;
+        while (right+1 < x1 && hiddenZero(right+1, y))
+            ++right;
+        for (int sx = left; sx <= right; ++sx)
+            reveal(board.storageIndex({sx,y}));
+
+        // from one cell before the run to one cell after it, in this row and
+        // the rows above and below: numbers are revealed, each run of hidden
+        // zeros gets one seed, and cells of other chunks go to the outbox
+        const int from = left > 0 ? left-1 : 0;
+        const int to = right+1 < cfg.cols ? right+1 : cfg.cols-1;
+        for (int ny = y-1; ny <= y+1; ++ny) {
+            if (ny < 0 || ny >= cfg.rows)
+                continue;
+
+            bool inRun = false;
+            for (int sx = from; sx <= to; ++sx) {
+                if (!inChunk(sx, ny)) {
+                    chunk.outbox.push_back(ny*cfg.cols + sx);
+                    inRun = false;
+                    continue;
+                }
+
+                const int next = board.storageIndex({sx,ny});
+                const Tile &tile = tiles[next];
+                if (tile.isRevealed) {
+                    inRun = false;
+                } else if (tile.numNeighbors != 0) {
+                    reveal(next);
+                    inRun = false;
+                } else if (!inRun) {
+                    chunk.seeds.push_back(ny*cfg.cols + sx);
+                    inRun = true;
+                }
+            }
+        }
+    }
+}
+
+void ParallelFlood::finish(GameBoard &board) {
+    if (!recordChanges)
+        board.changes.markFullRefresh();
+
+    for (int index : touched) {
+        Chunk &chunk = chunks[index];
+        board.hiddenSafeCount -= chunk.revealedCount;
+        board.flagCount -= chunk.flagsCleared;
+        if (recordChanges) {
+            for (int cell : chunk.revealed)
+                board.changes.record(cell, board.tiles[cell]);
+        }
+
+        chunk.revealed.clear();
+        chunk.revealedCount = 0;
+        chunk.flagsCleared = 0;
+        chunk.touched = false;
+    }
+}
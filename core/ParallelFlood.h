@@ -0,0 +1,65 @@
+#ifndef MINESWEEPER_PARALLELFLOOD_H
+#define MINESWEEPER_PARALLELFLOOD_H
+
+#include <cstddef>
+#include <vector>
+
+#include "BoardTypes.h"
+
+struct GameBoard;
+struct ThreadPool;
+
+// Reveals like GameBoard::floodFill, spread over a thread pool, for openings
+// of hundreds of thousands of cells. With valid region labels the opening's
+// cell and border lists are split into blocks, one tally per block; the lists
+// never repeat a cell, so blocks write disjoint tiles. With stale labels the
+// board is cut into 64x64 cell chunks and the fill runs in rounds: every chunk
+// with pending seeds fills its own part of the opening with a local scanline
+// fill, and cells it reaches outside its chunk become seeds of that chunk for
+// the next round. A chunk is only touched by the thread filling it, so no
+// locks or atomics are needed. Either way the revealed set is the same as the
+// serial fill. Small openings and single-thread pools use the serial path.
+struct ParallelFlood {
+    explicit ParallelFlood(ThreadPool &pool);
+
+    ParallelFlood(const ParallelFlood &) = delete;
+    ParallelFlood &operator=(const ParallelFlood &) = delete;
+
+    // true if floodFill() would go parallel for a click on coords
+    bool handles(const GameBoard &board, Vec2i coords) const;
+    void floodFill(GameBoard &board, Vec2i coords);
+
+private:
+    ThreadPool &pool;
+
+    // per chunk, cells are logical row-major indices (y*cols + x)
+    struct Chunk {
+        std::vector<int> seeds;    // pending, also the local fill stack
+        std::vector<int> outbox;   // reached cells of other chunks
+        std::vector<int> revealed; // storage indices, for the change list
+        int revealedCount = 0;
+        int flagsCleared = 0;
+        bool active = false;       // has seeds for the next round
+        bool touched = false;      // took part in this fill
+    };
+
+    // per block of a region list reveal
+    struct Block {
+        std::vector<int> revealed; // storage indices, for the change list
+        int revealedCount = 0;
+        int flagsCleared = 0;
+    };
+
+    int chunksX;
+    std::vector<Chunk> chunks;
+    std::vector<int> active, nextActive, touched;
+    std::vector<Block> blocks;
+    bool recordChanges; // false once the fill outgrew the change list
+
+    void revealRegion(GameBoard &board, int region);
+    void fillChunks(GameBoard &board, int seed);
+    void fillChunk(GameBoard &board, int chunk);
+    void finish(GameBoard &board);
+};
+
+#endif //MINESWEEPER_PARALLELFLOOD_H
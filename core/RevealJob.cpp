@@ -0,0 +1,94 @@
+#include "RevealJob.h"
+
+#include <algorithm>
+#include <chrono>
+
+#include "GameBoard.h"
+
+void RevealJob::start(GameBoard &board, Vec2i coords) {
+    const int index = board.storageIndex(coords);
+    start(board, &index, 1);
+}
+
+void RevealJob::start(GameBoard &board, const int *seeds, int count) {
+    for (int i = 0; i < count; ++i) {
+        const Tile &tile = board.tiles[seeds[i]];
+        if (tile.isRevealed || tile.isMine)
+            continue;
+
+        board.revealTile(seeds[i]);
+        if (tile.numNeighbors != 0)
+            continue;
+
+        if (!board.regions.valid) {
+            queue.push_back(seeds[i]);
+            continue;
+        }
+
+        // two seeds of a chord can share an opening
+        const int region = board.regions.label[seeds[i]];
+        if (std::find(regions.begin() + regionHead, regions.end(), region) == regions.end())
+            regions.push_back(region);
+    }
+}
+
+void RevealJob::revealListed(GameBoard &board) {
+    const ZeroRegions &labels = board.regions;
+    const int region = regions[regionHead];
+    const int cellCount = labels.cellStart[region+1] - labels.cellStart[region];
+    const int listed = cellCount + labels.borderStart[region+1] - labels.borderStart[region];
+
+    const int index = cursor < cellCount ? labels.cells[labels.cellStart[region] + cursor]
+                                         : labels.border[labels.borderStart[region] + cursor - cellCount];
+    if (!board.tiles[index].isRevealed)
+        board.revealTile(index);
+
+    if (++cursor == listed) {
+        cursor = 0;
+        regionHead++;
+    }
+}
+
+void RevealJob::expand(GameBoard &board) {
+    const int index = queue[head++];
+    for (int k = 0; k < 8; ++k) {
+        const int neighbor = board.neighborIndex(index, k);
+        const Tile &tile = board.tiles[neighbor];
+        if (tile.isRevealed) // also every sentinel
+            continue;
+
+        // a zero's neighbors are never mines
+        board.revealTile(neighbor);
+        if (tile.numNeighbors == 0)
+            queue.push_back(neighbor);
+    }
+}
+
+bool RevealJob::step(GameBoard &board, int budgetMicros) {
+    typedef std::chrono::steady_clock Clock;
+    const Clock::time_point deadline = Clock::now() + std::chrono::microseconds(budgetMicros);
+
+    while (running()) {
+        // reading the clock costs more than revealing a cell, so check in batches
+        for (int i = 0; i < 256 && running(); ++i) {
+            if (regionHead < regions.size())
+                revealListed(board);
+            else
+                expand(board);
+        }
+
+        if (running() && Clock::now() >= deadline)
+            return false;
+    }
+
+    cancel();
+    return true;
+}
+
+void RevealJob::cancel() {
+    queue.clear();
+    head = 0;
+    regions.clear();
+    regionHead = 0;
+    cursor = 0;
+}
@@ -0,0 +1,41 @@
+#ifndef MINESWEEPER_REVEALJOB_H
+#define MINESWEEPER_REVEALJOB_H
+
+#include <cstddef>
+#include <vector>
+
+#include "BoardTypes.h"
+
+struct GameBoard;
+
+// A flood fill spread over as many frames as it needs: step() reveals for at
+// most a given time and the next call picks up where it stopped. While the
+// board's region labels are valid an opening is walked from its cell and
+// border lists with a cursor, so nothing is searched again; otherwise cells go
+// breadth first from the clicked cell. Either way a big opening shows as a
+// cascade and the revealed set is the same as GameBoard::floodFill. The job
+// must be cancelled when the board is regenerated, loaded, swapped or edited.
+struct RevealJob {
+    // reveals the clicked cell right away, an opening is left for step();
+    // starting while a cascade runs joins it instead of cutting it short
+    void start(GameBoard &board, Vec2i coords);
+    // start() for several storage indices at once, e.g. the cells of a chord
+    void start(GameBoard &board, const int *seeds, int count);
+    // returns true once nothing is left to reveal
+    bool step(GameBoard &board, int budgetMicros);
+    void cancel();
+
+    bool running() const { return head < queue.size() || regionHead < regions.size(); }
+
+private:
+    std::vector<int> queue; // zero cells to expand, storage indices
+    size_t head = 0;
+    std::vector<int> regions; // labelled openings to reveal, regions[regionHead] first
+    size_t regionHead = 0;
+    int cursor = 0; // into that region's cells, then on into its border
+
+    void revealListed(GameBoard &board);
+    void expand(GameBoard &board);
+};
+
+#endif //MINESWEEPER_REVEALJOB_H
@@ -0,0 +1,11 @@
+#include "Rng.h"
+
+#include <chrono>
+#include <random>
+
+uint64_t randomSeed() {
+    std::random_device device;
+    const uint64_t entropy = (static_cast<uint64_t>(device()) << 32) | device();
+    const uint64_t now = static_cast<uint64_t>(std::chrono::high_resolution_clock::now().time_since_epoch().count());
+    return splitmix64(entropy ^ splitmix64(now));
+}
@@ -0,0 +1,63 @@
+#ifndef MINESWEEPER_RNG_H
+#define MINESWEEPER_RNG_H
+
+#include <cstdint>
+
+// splitmix64 step, also used on its own as a cheap 64-bit hash
+inline uint64_t splitmix64(uint64_t z) {
+    z += 0x9e3779b97f4a7c15ull;
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+    return z ^ (z >> 31);
+}
+
+// xoshiro256** with splitmix64 seeding. Small enough to keep one per board,
+// so boards can be generated from several threads and replayed from a seed.
+struct Rng {
+    uint64_t state[4];
+
+    explicit Rng(uint64_t seed) {
+        for (uint64_t &word : state) {
+            seed += 0x9e3779b97f4a7c15ull;
+            word = splitmix64(seed);
+        }
+    }
+
+    uint64_t next() {
+        const uint64_t result = rotl(state[1] * 5, 7) * 9;
+        const uint64_t t = state[1] << 17;
+
+        state[2] ^= state[0];
+        state[3] ^= state[1];
+        state[1] ^= state[2];
+        state[0] ^= state[3];
+        state[2] ^= t;
+        state[3] = rotl(state[3], 45);
+
+        return result;
+    }
+
+    // unbiased integer in [0, bound) (Lemire's multiply-shift with rejection)
+    uint32_t below(uint32_t bound) {
+        uint64_t product = static_cast<uint64_t>(next() >> 32) * bound;
+        uint32_t low = static_cast<uint32_t>(product);
+        if (low < bound) {
+            const uint32_t threshold = (0u - bound) % bound;
+            while (low < threshold) {
+                product = static_cast<uint64_t>(next() >> 32) * bound;
+                low = static_cast<uint32_t>(product);
+            }
+        }
+        return static_cast<uint32_t>(product >> 32);
+    }
+
+private:
+    static uint64_t rotl(uint64_t x, int k) {
+        return (x << k) | (x >> (64 - k));
+    }
+};
+
+// non-deterministic seed for boards that don't ask for a specific one
+uint64_t randomSeed();
+
+#endif //MINESWEEPER_RNG_H
@@ -0,0 +1,288 @@
+#include "Solver.h"
+
+#include "GameBoard.h"
+#include "Rng.h"
+
+Solver::Around Solver::around(const GameBoard &board, int index) {
+    Around result;
+    result.hiddenCount = 0;
+    result.flags = 0;
+
+    for (int k = 0; k < 8; ++k) {
+        const int neighbor = board.neighborIndex(index, k);
+        const Tile &tile = board.tiles[neighbor];
+        if (tile.isFlagged)
+            result.flags++;
+        else if (!tile.isRevealed)
+            result.hidden[result.hiddenCount++] = neighbor;
+    }
+    return result;
+}
+
+const Solver::Around &Solver::cachedAround(const GameBoard &board, int index) {
+    if (aroundStamp[index] != stamp) {
+        aroundStamp[index] = stamp;
+        aroundCache[index] = around(board, index);
+    }
+    return aroundCache[index];
+}
+
+bool Solver::contains(const Around &set, int index) {
+    for (int i = 0; i < set.hiddenCount; ++i) {
+        if (set.hidden[i] == index)
+            return true;
+    }
+    return false;
+}
+
+void Solver::push(int index) {
+    if (!queued[index]) {
+        queued[index] = 1;
+        worklist.push_back(index);
+    }
+}
+
+void Solver::pushRevealedAround(GameBoard &board, int index) {
+    for (int k = 0; k < 8; ++k) {
+        const int neighbor = board.neighborIndex(index, k);
+        const Tile &tile = board.tiles[neighbor];
+        if (tile.isRevealed && tile.numNeighbors > 0)
+            push(neighbor);
+    }
+}
+
+void Solver::revealCell(GameBoard &board, int index) {
+    ++stamp;
+    Tile &tile = board.tiles[index];
+    if (tile.numNeighbors) {
+        board.revealTile(index);
+        push(index);
+        return;
+    }
+
+    // opening: flood it, then queue every number on its border
+    board.floodFillAt(index);
+
+    const size_t start = worklist.size();
+    std::vector<int> &stack = worklist;
+    stack.push_back(index);
+    queued[index] = 1;
+    for (size_t i = start; i < stack.size(); ++i) {
+        const int current = stack[i];
+        if (board.tiles[current].numNeighbors)
+            continue;
+        for (int k = 0; k < 8; ++k) {
+            const int neighbor = board.neighborIndex(current, k);
+            const Tile &next = board.tiles[neighbor];
+            if (next.isRevealed && next.numNeighbors >= 0 && !queued[neighbor]) {
+                queued[neighbor] = 1;
+                stack.push_back(neighbor);
+            }
+        }
+    }
+}
+
+void Solver::flagCell(GameBoard &board, int index) {
+    ++stamp;
+    board.setFlag(index, true);
+    pushRevealedAround(board, index);
+}
+
+bool Solver::applySingle(GameBoard &board, int index) {
+    const Tile &tile = board.tiles[index];
+    if (!tile.isRevealed || tile.numNeighbors <= 0)
+        return false;
+
+    const Around cells = around(board, index);
+    if (cells.hiddenCount == 0)
+        return false;
+
+    const int remaining = tile.numNeighbors - cells.flags;
+    if (remaining == 0) {
+        for (int i = 0; i < cells.hiddenCount; ++i) {
+            if (!board.tiles[cells.hidden[i]].isRevealed)
+                revealCell(board, cells.hidden[i]);
+        }
+        return true;
+    }
+    if (remaining == cells.hiddenCount) {
+        for (int i = 0; i < cells.hiddenCount; ++i)
+            flagCell(board, cells.hidden[i]);
+        return true;
+    }
+    return false;
+}
+
+bool Solver::applyPairs(GameBoard &board) {
+    const Config &cfg = board.cfg;
+    bool progress = false;
+
+    for (int y = 0; y < cfg.rows; ++y) {
+        for (int x = 0; x < cfg.cols; ++x) {
+            const int a = board.storageIndex({x,y});
+            const Tile &tileA = board.tiles[a];
+            if (!tileA.isRevealed || tileA.numNeighbors <= 0)
+                continue;
+
+            Around cellsA = cachedAround(board, a);
+            if (cellsA.hiddenCount == 0)
+                continue;
+
+            // numbers sharing hidden cells with A are at most two cells away
+            for (int by = y-2; by <= y+2; ++by) {
+                for (int bx = x-2; bx <= x+2; ++bx) {
+                    if ((bx == x && by == y) || !board.coordsExist({bx,by}))
+                        continue;
+
+                    const int b = board.storageIndex({bx,by});
+                    const Tile &tileB = board.tiles[b];
+                    if (!tileB.isRevealed || tileB.numNeighbors <= 0)
+                        continue;
+
+                    const Around &cellsB = cachedAround(board, b);
+                    int shared = 0;
+                    for (int i = 0; i < cellsA.hiddenCount; ++i)
+                        shared += contains(cellsB, cellsA.hidden[i]);
+                    if (shared == 0)
+                        continue;
+
+                    const int remainingA = tileA.numNeighbors - cellsA.flags;
+                    const int remainingB = tileB.numNeighbors - cellsB.flags;
+                    const int onlyA = cellsA.hiddenCount - shared;
+                    const int onlyB = cellsB.hiddenCount - shared;
+
+                    // fewest mines the shared cells can hold, given what B's own cells can take
+                    int sharedMin = remainingB - onlyB;
+                    if (sharedMin < 0)
+                        sharedMin = 0;
+                    int sharedMax = shared;
+                    if (sharedMax > remainingA)
+                        sharedMax = remainingA;
+                    if (sharedMax > remainingB)
+                        sharedMax = remainingB;
+
+                    // mines left for A's own cells lie in [remainingA - sharedMax, remainingA - sharedMin]
+                    const bool onlyASafe = onlyA > 0 && remainingA - sharedMin == 0;
+                    const bool onlyAMines = onlyA > 0 && remainingA - sharedMax == onlyA;
+                    if (!onlyASafe && !onlyAMines)
+                        continue;
+
+                    for (int i = 0; i < cellsA.hiddenCount; ++i) {
+                        const int cell = cellsA.hidden[i];
+                        if (contains(cellsB, cell) || board.tiles[cell].isRevealed || board.tiles[cell].isFlagged)
+                            continue;
+                        if (onlyASafe)
+                            revealCell(board, cell);
+                        else
+                            flagCell(board, cell);
+                    }
+                    progress = true;
+
+                    cellsA = cachedAround(board, a);
+                    if (cellsA.hiddenCount == 0)
+                        break;
+                }
+                if (cellsA.hiddenCount == 0)
+                    break;
+            }
+        }
+    }
+    return progress;
+}
+
+bool Solver::applyMineCount(GameBoard &board) {
+    const Config &cfg = board.cfg;
+    const int minesLeft = board.mineCount - board.flagCount;
+
+    // Numbers whose hidden cells don't overlap each hold exactly their
+    // remaining count, so packing such numbers gives a lower bound on the
+    // mines they cover. Once it reaches every mine left, all hidden cells
+    // outside the packed numbers are safe; with no mines left that is all of them.
+    packed.assign(board.tiles.size(), 0);
+    int covered = 0;
+    for (int y = 0; y < cfg.rows && covered < minesLeft; ++y) {
+        for (int x = 0; x < cfg.cols && covered < minesLeft; ++x) {
+            const int index = board.storageIndex({x,y});
+            const Tile &tile = board.tiles[index];
+            if (!tile.isRevealed || tile.numNeighbors <= 0)
+                continue;
+
+            const Around cells = around(board, index);
+            bool disjoint = cells.hiddenCount > 0;
+            for (int i = 0; i < cells.hiddenCount && disjoint; ++i)
+                disjoint = !packed[cells.hidden[i]];
+            if (!disjoint)
+                continue;
+
+            for (int i = 0; i < cells.hiddenCount; ++i)
+                packed[cells.hidden[i]] = 1;
+            covered += tile.numNeighbors - cells.flags;
+        }
+    }
+    if (covered < minesLeft)
+        return false;
+
+    bool progress = false;
+    for (int y = 0; y < cfg.rows; ++y) {
+        for (int x = 0; x < cfg.cols; ++x) {
+            const int index = board.storageIndex({x,y});
+            const Tile &tile = board.tiles[index];
+            if (!tile.isRevealed && !tile.isFlagged && !packed[index]) {
+                revealCell(board, index);
+                progress = true;
+            }
+        }
+    }
+    return progress;
+}
+
+bool Solver::solve(GameBoard &board) {
+    queued.assign(board.tiles.size(), 0);
+    worklist.clear();
+    aroundCache.resize(board.tiles.size());
+    aroundStamp.assign(board.tiles.size(), 0);
+    stamp = 1;
+
+    for (int y = 0; y < board.cfg.rows; ++y) {
+        for (int x = 0; x < board.cfg.cols; ++x) {
+            const int index = board.storageIndex({x,y});
+            if (board.tiles[index].isRevealed && board.tiles[index].numNeighbors)
+                push(index);
+        }
+    }
+
+    for (;;) {
+        while (!worklist.empty()) {
+            const int index = worklist.back();
+            worklist.pop_back();
+            queued[index] = 0;
+            applySingle(board, index);
+        }
+
+        if (board.areWeWinners())
+            return true;
+        if (!applyPairs(board) && !applyMineCount(board))
+            return false;
+    }
+}
+
+bool generateNoGuess(GameBoard &board, Vec2i firstClick, uint64_t seed, int maxAttempts) {
+    Solver solver;
+
+    // attempts are played once and thrown away, only the handed out board gets labelled
+    const bool labelOpenings = board.labelOpenings;
+    board.labelOpenings = false;
+
+    bool solved = false;
+    uint64_t boardSeed = 0;
+    for (int attempt = 0; attempt < maxAttempts && !solved; ++attempt) {
+        boardSeed = splitmix64(seed + attempt);
+        board.generate(boardSeed, firstClick);
+        board.floodFill(firstClick);
+        solved = solver.solve(board);
+    }
+
+    board.labelOpenings = labelOpenings;
+    board.generate(solved ? boardSeed : board.seed, firstClick);
+    return solved;
+}
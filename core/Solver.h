@@ -0,0 +1,56 @@
+#ifndef MINESWEEPER_SOLVER_H
+#define MINESWEEPER_SOLVER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "BoardTypes.h"
+
+struct GameBoard;
+
+// Deterministic solver that only makes forced moves: single-number rules,
+// pairwise overlap rules between nearby numbers and the global mine count
+// (once non-overlapping numbers account for every mine left, all other hidden
+// cells are safe). It plays the board through GameBoard::floodFill()/reveal()
+// and flags, so a board it clears behaves exactly the same for a player.
+struct Solver {
+    // plays from the board's current state, returns true if every safe cell
+    // got revealed without guessing; the board is left solved or stuck
+    bool solve(GameBoard &board);
+
+private:
+    // hidden (unrevealed, unflagged) neighbors and flag count around a number
+    struct Around {
+        int hidden[8];
+        int hiddenCount;
+        int flags;
+    };
+
+    std::vector<int> worklist;
+    std::vector<char> queued;
+    std::vector<Around> aroundCache;
+    std::vector<unsigned> aroundStamp;
+    std::vector<char> packed; // hidden cells of the numbers applyMineCount packed
+    unsigned stamp; // bumped on every reveal/flag, invalidates aroundCache
+
+    static Around around(const GameBoard &board, int index);
+    static bool contains(const Around &set, int index);
+    const Around &cachedAround(const GameBoard &board, int index);
+
+    void push(int index);
+    void pushRevealedAround(GameBoard &board, int index);
+    void revealCell(GameBoard &board, int index);
+    void flagCell(GameBoard &board, int index);
+    bool applySingle(GameBoard &board, int index);
+    bool applyPairs(GameBoard &board);
+    bool applyMineCount(GameBoard &board);
+};
+
+// Generates whole boards, each from a new seed, until the solver clears one
+// from `firstClick` without guessing, returns false if none of `maxAttempts` boards qualified (the board
+// then holds the last attempt). On success board.seed replays the board via
+// generate(board.seed, firstClick).
+bool generateNoGuess(GameBoard &board, Vec2i firstClick, uint64_t seed, int maxAttempts = 10000);
+
+#endif //MINESWEEPER_SOLVER_H
@@ -0,0 +1,81 @@
+#include "ThreadPool.h"
+
+ThreadPool::ThreadPool(unsigned threads)
+        : job(nullptr), jobCount(0), jobGrain(1), nextBlock(0), busyWorkers(0), generation(0), stopping(false) {
+    if (threads == 0)
+        threads = std::thread::hardware_concurrency();
+    if (threads == 0)
+        threads = 1;
+
+    for (unsigned i = 1; i < threads; ++i)
+        workers.emplace_back(&ThreadPool::workerLoop, this);
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+
+    for (std::thread &worker : workers)
+        worker.join();
+}
+
+void ThreadPool::parallelFor(size_t count, size_t grain, const RangeFn &fn) {
+    if (grain == 0)
+        grain = 1;
+
+    if (workers.empty() || count <= grain) {
+        if (count)
+            fn(0, count);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        job = &fn;
+        jobCount = count;
+        jobGrain = grain;
+        nextBlock = 0;
+        busyWorkers = static_cast<unsigned>(workers.size());
+        ++generation;
+    }
+    wake.notify_all();
+
+    runBlocks();
+
+    std::unique_lock<std::mutex> lock(mutex);
+    finished.wait(lock, [this] { return busyWorkers == 0; });
+    job = nullptr;
+}
+
+void ThreadPool::runBlocks() {
+    const size_t blocks = (jobCount + jobGrain - 1) / jobGrain;
+
+    for (size_t block = nextBlock++; block < blocks; block = nextBlock++) {
+        const size_t begin = block * jobGrain;
+        const size_t end = begin + jobGrain < jobCount ? begin + jobGrain : jobCount;
+        (*job)(begin, end);
+    }
+}
+
+void ThreadPool::workerLoop() {
+    uint64_t seenGeneration = 0;
+
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [&] { return stopping || generation != seenGeneration; });
+            if (stopping)
+                return;
+            seenGeneration = generation;
+        }
+
+        runBlocks();
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if (--busyWorkers == 0)
+            finished.notify_one();
+    }
+}
@@ -0,0 +1,51 @@
+#ifndef MINESWEEPER_THREADPOOL_H
+#define MINESWEEPER_THREADPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed set of worker threads for data-parallel loops. The calling thread
+// joins in, so a pool of size 1 has no workers and runs everything inline.
+// Only one parallelFor may run on a pool at a time.
+struct ThreadPool {
+    typedef std::function<void(size_t begin, size_t end)> RangeFn;
+
+    // threads == 0 uses std::thread::hardware_concurrency()
+    explicit ThreadPool(unsigned threads = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    // threads taking part in a parallelFor, including the caller
+    unsigned size() const { return static_cast<unsigned>(workers.size()) + 1; }
+
+    // runs fn over [0, count) in blocks of `grain` items, handing blocks to
+    // whichever thread is free next, and returns once every block is done
+    void parallelFor(size_t count, size_t grain, const RangeFn &fn);
+
+private:
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable finished;
+
+    const RangeFn *job;
+    size_t jobCount;
+    size_t jobGrain;
+    std::atomic<size_t> nextBlock;
+    unsigned busyWorkers;
+    uint64_t generation;
+    bool stopping;
+
+    void workerLoop();
+    void runBlocks();
+};
+
+#endif //MINESWEEPER_THREADPOOL_H
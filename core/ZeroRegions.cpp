@@ -0,0 +1,69 @@
+#include "ZeroRegions.h"
+
+#include <cstddef>
+
+#include "GameBoard.h"
+
+namespace {
+
+// templated on the grid so row-major boards get plain offset neighbors
+template <class Grid>
+void label(ZeroRegions &regions, const Tile *tiles, const Grid &grid)
+{
+    std::vector<int> &label = regions.label;
+    std::vector<int> &cells = regions.cells;
+    std::vector<int> &border = regions.border;
+
+    for (int y = 0; y < grid.rows; ++y) {
+        for (int x = 0; x < grid.cols; ++x) {
+            const int seed = grid.index(x, y);
+            if (label[seed] != -1 || tiles[seed].isMine || tiles[seed].numNeighbors != 0)
+                continue;
+
+            // breadth first, using the region's own slice of `cells` as the queue
+            const int region = regions.count();
+            label[seed] = region;
+            cells.push_back(seed);
+            for (size_t i = regions.cellStart.back(); i < cells.size(); ++i) {
+                for (int k = 0; k < 8; ++k) {
+                    const int neighbor = grid.neighbor(cells[i], k);
+                    const Tile &tile = tiles[neighbor];
+                    if (tile.numNeighbors == 0) {
+                        if (label[neighbor] == -1) {
+                            label[neighbor] = region;
+                            cells.push_back(neighbor);
+                        }
+                    } else if (tile.numNeighbors > 0 && label[neighbor] != -2-region) {
+                        // a zero's neighbors are never mines, sentinels are -1;
+                        // border cells borrow their label as a "listed by region" mark
+                        label[neighbor] = -2-region;
+                        border.push_back(neighbor);
+                    }
+                }
+            }
+
+            regions.cellStart.push_back(static_cast<int>(cells.size()));
+            regions.borderStart.push_back(static_cast<int>(border.size()));
+        }
+    }
+
+    for (size_t i = 0; i < border.size(); ++i)
+        label[border[i]] = -1;
+}
+
+}
+
+void ZeroRegions::build(const GameBoard &board)
+{
+    label.assign(board.tiles.size(), -1);
+    cellStart.assign(1, 0);
+    borderStart.assign(1, 0);
+    cells.clear();
+    border.clear();
+
+    if (board.storage == TileStorage::Chunked)
+        ::label(*this, board.tiles.data(), board.chunkGrid);
+    else
+        ::label(*this, board.tiles.data(), board.grid);
+    valid = true;
+}
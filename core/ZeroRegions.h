@@ -0,0 +1,27 @@
+#ifndef MINESWEEPER_ZEROREGIONS_H
+#define MINESWEEPER_ZEROREGIONS_H
+
+#include <vector>
+
+struct GameBoard;
+
+// Connected openings (8-connected zero cells) of a board, labelled once per
+// generate()/loadBoard(). Each region keeps its cells and its numbered border
+// in flat arrays: region r owns cells[cellStart[r] .. cellStart[r+1]) and
+// border[borderStart[r] .. borderStart[r+1]), all as storage indices.
+struct ZeroRegions {
+    std::vector<int> label; // per storage index, region of a zero cell or -1
+    std::vector<int> cellStart;
+    std::vector<int> cells;
+    std::vector<int> borderStart;
+    std::vector<int> border;
+    bool valid = false; // cleared by mine edits, the lists no longer match the board
+
+    void build(const GameBoard &board);
+
+    int count() const {
+        return cellStart.empty() ? 0 : static_cast<int>(cellStart.size()) - 1;
+    }
+};
+
+#endif //MINESWEEPER_ZEROREGIONS_H
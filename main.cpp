@@ -1,246 +1,31 @@
 #include <SFML/Window.hpp>
 #include <SFML/Graphics.hpp>
 
-struct Tile {
-    bool isFlagged;
-    bool isMine;
-    bool isRevealed;
-    sf::FloatRect rect;
-    int numNeighbors; // if !isMine
-
-    Tile() : isMine(0), isFlagged(0), isRevealed(0), rect(0,0,0,0), numNeighbors(0) {}
-};
-
-struct Config {
-    int rows,cols,numMines;
-};
-
-struct GameBoard {
-    std::vector<Tile> tiles;
-    sf::FloatRect parentRect;
-    Config cfg;
-    int mineCount;
-    int flagCount;
-
-    void flagAllMines() {
-        for (auto& tile : tiles) {
-            if (tile.isMine) {
-                tile.isFlagged = true;
-            } else {
-                tile.isFlagged = false;
-            }
-        }
-        flagCount = mineCount;
-    }
-
-    void updateParentRect(const sf::FloatRect &rect) {
-        parentRect = rect;
-
-        for (int y = 0; y < cfg.rows; ++y) {
-            for (int x = 0; x < cfg.cols; ++x) {
-                float tileX = rect.left + (static_cast<float>(x)/static_cast<float>(cfg.cols)) * rect.width;
-                float tileY = rect.top + ((static_cast<float>(y)/static_cast<float>(cfg.rows))) * rect.height;
-                float tileWidth = rect.width / static_cast<float>(cfg.cols);
-                float tileHeight = rect.height / static_cast<float>(cfg.rows);
-
-                Tile &tile = accessTile({x,y});
-                tile.rect = sf::FloatRect(tileX,tileY,tileWidth,tileHeight);
-            }
-        }
-    }
-
-    void computeNeighbors()
-    {
-        for (int y = 0; y < cfg.rows; ++y) {
-            for (int x = 0; x < cfg.cols; ++x) {
-                Tile& tile = accessTile({x,y});
-                if (!tile.isMine) {
-                    auto neighborTiles = gatherFromCoords({
-                                                                  {x-1,y-1},
-                                                                  {x,  y-1},
-                                                                  {x+1,y-1},
-                                                                  {x-1,y  },
-                                                                  {x+1,y  },
-                                                                  {x-1,y+1},
-                                                                  {x,  y+1},
-                                                                  {x+1,y+1}
-                                                          });
-
-                    for (const Tile &neighbor : neighborTiles)
-                        tile.numNeighbors += neighbor.isMine;
-                }
-            }
-        }
-    }
-
-    GameBoard(sf::FloatRect rect, const Config &config) : parentRect(rect), cfg(config), mineCount(0), flagCount(0) {
-        tiles.resize(cfg.cols*cfg.rows);
-        generate();
-    }
-
-    void generate()
-    {
-        tiles.clear();
-        tiles.resize(cfg.cols*cfg.rows);
-        mineCount = 0;
-        flagCount = 0;
-        srand(time(NULL));
-
-        std::vector<sf::Vector2i> minePositions;
-
-        mineCount = cfg.numMines;
-        for (int i = 0; i < mineCount; ++i) {
-            bool alreadyExists = true;
-            sf::Vector2i pos;
-
-            while (alreadyExists) {
-                alreadyExists = false;
-                pos = sf::Vector2i(rand()%cfg.cols,rand()%cfg.rows);
-                for (const auto& minePos: minePositions) {
-                    if (pos == minePos) {
-                        alreadyExists = true;
-                        break;
-                    }
-                }
-            }
-
-            minePositions.push_back(pos);
-        }
-
-        // write default tiles
-        for (int y = 0; y < cfg.rows; ++y) {
-            for (int x = 0; x < cfg.cols; ++x) {
-                float tileX = parentRect.left + static_cast<float>(x)/static_cast<float>(cfg.cols) * parentRect.width;
-                float tileY = parentRect.top + static_cast<float>(y)/static_cast<float>(cfg.rows) * parentRect.height;
-                float tileWidth = parentRect.width / static_cast<float>(cfg.cols);
-                float tileHeight = parentRect.height / static_cast<float>(cfg.rows);
-
-                Tile tile;
-                tile.rect = sf::FloatRect(tileX,tileY,tileWidth,tileHeight);
-                tile.isRevealed = false;
-                tile.numNeighbors = 0;
-                tile.isMine = false;
-
-                tiles[y*cfg.cols+x] = tile;
-            }
-        }
-
-        // write mines
-        for (const auto& minePos: minePositions) {
-            tiles[minePos.y*cfg.cols+minePos.x].isMine = true;
-        }
-
-        computeNeighbors();
-    }
-
-    Tile &accessTile(sf::Vector2i coords) {
-        return tiles[coords.y*cfg.cols+coords.x];
-    }
-
-    bool coordsExist(sf::Vector2i coords) {
-        return coords.x >= 0 && coords.x < cfg.cols && coords.y >= 0 && coords.y < cfg.rows;
-    }
-
-    void floodFill(sf::Vector2i coords) {
-        Tile &currTile = accessTile(coords);
-        if (!currTile.isRevealed && !currTile.isMine) {
-            currTile.isRevealed = true;
-            if (currTile.isFlagged) {
-                flagCount--;
-                currTile.isFlagged= false;
-            }
-
-            auto fillNeighbor = [&](int x, int y) {
-                sf::Vector2i adjacentCoords = {x,y};
-                if (coordsExist(adjacentCoords)) {
-                    floodFill(adjacentCoords);
-                }
-            };
-
-            if (currTile.numNeighbors == 0) {
-                fillNeighbor(coords.x-1,coords.y-1);
-                fillNeighbor(coords.x,coords.y-1);
-                fillNeighbor(coords.x+1,coords.y-1);
-                fillNeighbor(coords.x-1,coords.y);
-                fillNeighbor(coords.x+1,coords.y);
-                fillNeighbor(coords.x-1,coords.y+1);
-                fillNeighbor(coords.x,coords.y+1);
-                fillNeighbor(coords.x+1,coords.y+1);
-            }
-        }
-
-    }
-
-    std::vector<Tile> gatherFromCoords(const std::vector<sf::Vector2i> &positions) {
-        std::vector<Tile> coordTiles;
-        for (auto &pos : positions) {
-            if (coordsExist(pos)) {
-                coordTiles.push_back(accessTile(pos));
-            }
-        }
-        return coordTiles;
-    }
-
-    void loadBoard(char board[]) {
-        tiles.clear();
-        mineCount = 0;
-        flagCount = 0;
-        tiles.resize(cfg.cols*cfg.rows);
-
-        for (int y = 0; y < cfg.rows; ++y) {
-            for (int x = 0; x < cfg.cols; ++x) {
-                float tileX = parentRect.left + static_cast<float>(x)/static_cast<float>(cfg.cols) * parentRect.width;
-                float tileY = parentRect.top + static_cast<float>(y)/static_cast<float>(cfg.rows) * parentRect.height;
-                float tileWidth = parentRect.width / static_cast<float>(cfg.cols);
-                float tileHeight = parentRect.height / static_cast<float>(cfg.rows);
-
-                Tile tile;
-
-                tile.rect = sf::FloatRect(tileX,tileY,tileWidth,tileHeight);
-                tile.isRevealed = false;
-                tile.numNeighbors = 0;
-
-                long off1 = y*(cfg.cols+1)+x; // +1 for \n in string
-                long off2 = y*cfg.cols+x;
-                if (board[off1] == '1') {
-                    tile.isMine = true;
-                }  else if (board[off1] == '0') {
-                    tile.isMine = false;
-                }
-
-                if (tile.isMine) ++mineCount;
-
-                tiles[off2] = tile;
-            }
-        }
-        computeNeighbors();
-    }
-
-    bool mouseOverTile(sf::Vector2i &tileCoords, const sf::Vector2f &mousePos) {
-        for (int y = 0; y < cfg.rows; ++y) {
-            for (int x = 0; x < cfg.cols; ++x) {
-                Tile& tile = accessTile({x,y});
-                if (tile.rect.contains( mousePos )) {
-                    // this is the tile that was clicked, break out
-                    tileCoords = {x,y};
-                    return true;
-                }
-            }
-        }
-
-        return false;
-    }
+#include <vector>
+
+#include "BoardJob.h"
+#include "BoardPool.h"
+#include "GameBoard.h"
+#include "FileIO.h"
+#include "ParallelFlood.h"
+#include "Rng.h"
+#include "RevealJob.h"
+#include "ThreadPool.h"
+
+static FloatRect toCore(const sf::FloatRect &rect) {
+    return FloatRect{rect.left, rect.top, rect.width, rect.height};
+}
 
-    // check winning state by making sure all unrevealed cells are mines
-    bool areWeWinners() {
-        for (const Tile &tile : tiles) {
-            if (!tile.isRevealed && !tile.isMine) {
-                return false;
-            }
-        }
+static Vec2f toCore(const sf::Vector2i &pos) {
+    return Vec2f{static_cast<float>(pos.x), static_cast<float>(pos.y)};
+}
 
-        return true;
-    }
+// one mouse release, in the order the events arrived
+struct Click {
+    enum Action { Reveal, Flag, Chord } action;
+    sf::Vector2i pos; // from the event, not the mouse position at frame time
+    sf::Time time;    // since startup, taken when the event is polled: SFML 2
+                      // events carry no timestamp, so clicks in one frame are close
 };
 
 struct Button {
@@ -254,46 +39,6 @@ struct Button {
     }
 };
 
-char *loadFile(const char *path)
-{
-    FILE *file = fopen(path, "rb");
-
-    if (file != nullptr) {
-        fseek(file, 0, SEEK_END);
-        long size = ftell(file);
-        fseek(file, 0, SEEK_SET);
-
-        char *data = new char[size +1]();
-        fread(data,1,size,file);
-        data[size]='\0';
-
-        fclose(file);
-
-        return data;
-    } else {
-        fprintf(stderr, "Failed to load file %s!\n", path);
-    }
-
-    return nullptr;
-}
-
-
-bool loadConfig(Config *config, const char *filename)
-{
-    FILE *fp = fopen(filename, "rb");
-
-    if (fp != nullptr) {
-        fscanf(fp,"%d",&config->cols);
-        fscanf(fp,"%d",&config->rows);
-        fscanf(fp,"%d",&config->numMines);
-
-        fclose(fp);
-        return true;
-    }
-
-    return false;
-}
-
 int main(int argc, char *argv[])
 {
     sf::Texture mineTex;
@@ -365,14 +110,27 @@ int main(int argc, char *argv[])
 
     Config config;
     loadConfig(&config, "boards/config.cfg");
-    GameBoard gameBoard = GameBoard(targetRect, config);
+    GameBoard gameBoard = GameBoard(toCore(targetRect), config);
+    BoardPool boardPool(config); // boards for instant restarts
+    BoardJob boardJob(config);   // generate/load off the render thread when the pool is empty
+    RevealJob revealJob;         // openings are revealed over as many frames as they need
+    ThreadPool revealPool;
+    ParallelFlood parallelFlood(revealPool); // openings too big to cascade, all cores at once
+    const int revealBudgetMicros = 4000; // per frame, keeps big cascades from stalling the window
 
     bool showAllMines = false;
     int gameOverState = 0; // 0 : not-done, 1 : failed , 2 : success
+    bool firstClickPending = config.noGuess; // no-guess boards are built around the first click
+    bool firstClickQueued = false; // revealed once the no-guess board is ready
+    Vec2i firstClick = {0,0};
+    bool ignoreNextRelease = false; // the second button of a left+right chord
+    bool leftDown = false, rightDown = false; // from this window's events, in event order
+    sf::Clock inputClock;
+    std::vector<Click> clicks; // this frame's clicks, applied in order
 
     while (window.isOpen()) {
         sf::Event event;
-        bool lmbClicked = false, rmbClicked = false;
+        clicks.clear();
 
         while (window.pollEvent(event))
         {
@@ -390,13 +148,48 @@ int main(int argc, char *argv[])
                 // and align shape
             }
 
-            if (event.type == sf::Event::MouseButtonReleased) {
-                if (event.mouseButton.button == sf::Mouse::Left) {
-                    lmbClicked = true;
-                }
+            if (event.type == sf::Event::LostFocus) {
+                // a release outside the window never arrives, so a chord's
+                // leftover release must not swallow the next click either
+                leftDown = false;
+                rightDown = false;
+                ignoreNextRelease = false;
+            }
+
+            if (event.type == sf::Event::MouseButtonPressed) {
+                if (event.mouseButton.button == sf::Mouse::Left)
+                    leftDown = true;
+                if (event.mouseButton.button == sf::Mouse::Right)
+                    rightDown = true;
+            }
 
-                if (event.mouseButton.button == sf::Mouse::Right) {
-                    rmbClicked = true;
+            if (event.type == sf::Event::MouseButtonReleased) {
+                const Click click = {Click::Reveal, {event.mouseButton.x, event.mouseButton.y},
+                                     inputClock.getElapsedTime()};
+                const sf::Mouse::Button button = event.mouseButton.button;
+                const bool leftOrRight = button == sf::Mouse::Left || button == sf::Mouse::Right;
+                // the live button state could already be past this event, so use the tracked one
+                const bool otherDown = button == sf::Mouse::Left ? rightDown : leftDown;
+                if (button == sf::Mouse::Left)
+                    leftDown = false;
+                if (button == sf::Mouse::Right)
+                    rightDown = false;
+
+                if (leftOrRight && ignoreNextRelease) {
+                    ignoreNextRelease = false;
+                } else if (button == sf::Mouse::Middle) {
+                    clicks.push_back(click);
+                    clicks.back().action = Click::Chord;
+                } else if (leftOrRight && otherDown) {
+                    // both buttons down: chord, and swallow the other button's release
+                    clicks.push_back(click);
+                    clicks.back().action = Click::Chord;
+                    ignoreNextRelease = true;
+                } else if (button == sf::Mouse::Left) {
+                    clicks.push_back(click);
+                } else if (button == sf::Mouse::Right) {
+                    clicks.push_back(click);
+                    clicks.back().action = Click::Flag;
                 }
             }
         }
@@ -408,7 +201,7 @@ int main(int argc, char *argv[])
                 viewSize.x,
                 viewSize.y*.9f
         };
-        gameBoard.updateParentRect(targetRect);
+        gameBoard.updateParentRect(toCore(targetRect));
 
         const float buttonLength = targetRect.height*.1f;
 
@@ -428,102 +221,145 @@ int main(int argc, char *argv[])
         Button test3Btn({targetRect.width-+buttonLength*1,targetRect.height,buttonLength,buttonLength},
                         test3_tex);
 
-        // update board
-        if (!gameOverState) {
-            if (lmbClicked) {
-                // left click...
-                sf::Vector2i tileCoords;
+        // a board generated or loaded in the background is ready
+        if (boardJob.poll(gameBoard) && firstClickQueued) {
+            revealJob.start(gameBoard, firstClick);
+            firstClickQueued = false;
+        }
 
-                if (gameBoard.mouseOverTile(tileCoords, sf::Vector2f(sf::Mouse::getPosition(window)))) {
+        for (const Click &click : clicks) {
+            const Vec2f mousePos = toCore(click.pos);
+            const sf::Vector2f buttonPos(click.pos);
+
+            // update board
+            if (!gameOverState && !boardJob.running()) {
+                Vec2i tileCoords;
+                const bool onTile = gameBoard.mouseOverTile(tileCoords, mousePos);
+
+                if (click.action == Click::Reveal && onTile && firstClickPending) {
+                    // the board is built around this click, which is revealed when it's ready
+                    boardJob.startNoGuess(tileCoords, randomSeed());
+                    firstClickPending = false;
+                    firstClickQueued = true;
+                    firstClick = tileCoords;
+                } else if (click.action == Click::Reveal && onTile) {
+                    // left click...
                     Tile& tile  = gameBoard.accessTile(tileCoords);
                     if (!tile.isFlagged) {
                         if (tile.isMine) {
                             // game over, failed!
                             gameOverState = 1;
+                        } else if (parallelFlood.handles(gameBoard, tileCoords)) {
+                            // would take hundreds of frames as a cascade
+                            parallelFlood.floodFill(gameBoard, tileCoords);
                         } else {
-                            if (tile.numNeighbors) {
-                                tile.isRevealed = true;
-                            } else
-                                gameBoard.floodFill(tileCoords);
+                            revealJob.start(gameBoard, tileCoords);
                         }
                     }
+                }
 
-                    if (gameBoard.areWeWinners()) {
-                        gameBoard.flagAllMines();
-                        gameOverState = 2;// won!
-                        showAllMines = false;
+                if (click.action == Click::Chord && onTile) {
+                    // middle click or both buttons on a number: open its unflagged neighbors,
+                    // openings among them cascade like a left click
+                    bool hitMine = false;
+                    int seeds[8];
+                    const int seedCount = gameBoard.chordSeeds(tileCoords, seeds, hitMine);
+                    revealJob.start(gameBoard, seeds, seedCount);
+                    if (hitMine) {
+                        // a flag was wrong, failed!
+                        gameOverState = 1;
                     }
                 }
-            }
-
-            if (rmbClicked) {
-                // right click ... place flag
 
-                sf::Vector2i tileCoords;
-                if (gameBoard.mouseOverTile(tileCoords, sf::Vector2f(sf::Mouse::getPosition(window)))) {
-                    Tile& tile  = gameBoard.accessTile(tileCoords);
-                    if (!tile.isRevealed) {
-                        if (tile.isFlagged) {
-                            gameBoard.flagCount--;
-                        } else {
-                            gameBoard.flagCount++;
-                        }
-
-                        tile.isFlagged = !tile.isFlagged;
-                    }
+                if (click.action == Click::Flag && onTile) {
+                    // right click ... place flag
+                    gameBoard.toggleFlag(tileCoords);
                 }
-            }
 
-            if (lmbClicked) {
-                if (debugBtn.rect.contains(sf::Vector2f(sf::Mouse::getPosition(window)))) {
+                if (click.action == Click::Reveal && debugBtn.rect.contains(buttonPos)) {
                     showAllMines = !showAllMines;
                 }
             }
-        }
 
-        // update game
-        if (lmbClicked) {
-            sf::Vector2f mousePos = sf::Vector2f(sf::Mouse::getPosition(window));
-            if (smilyButtonRect.contains(mousePos)) {
+            // update game
+            if (click.action != Click::Reveal)
+                continue;
+
+            if (smilyButtonRect.contains(buttonPos)) {
                 // reset game by clicking on smily
                 gameOverState = 0;
-                gameBoard.generate();
+                revealJob.cancel();
+                if (!boardJob.running() && !boardPool.take(gameBoard))
+                    boardJob.startGenerate(randomSeed());
+                firstClickPending = config.noGuess;
+                firstClickQueued = false;
             }
 
-            if (test1Btn.rect.contains(mousePos)) {
+            // like the smiley, test boards wait for a running job: starting one
+            // would block this thread until the running one is done
+            if (test1Btn.rect.contains(buttonPos) && !boardJob.running()) {
                 char *board = loadFile("boards/testboard1.brd");
                 if (board != nullptr) {
                     gameOverState = 0;
-                    gameBoard.loadBoard(board);
+                    revealJob.cancel();
+                    boardJob.startLoad(board);
+                    firstClickPending = false;
+                    firstClickQueued = false;
                 }
                 delete[] board;
             }
 
-            if (test2Btn.rect.contains(mousePos)) {
+            if (test2Btn.rect.contains(buttonPos) && !boardJob.running()) {
                 char *board = loadFile("boards/testboard2.brd");
                 if (board != nullptr) {
                     gameOverState = 0;
-                    gameBoard.loadBoard(board);
+                    revealJob.cancel();
+                    boardJob.startLoad(board);
+                    firstClickPending = false;
+                    firstClickQueued = false;
                 }
                 delete[] board;
             }
 
-            if (test3Btn.rect.contains(mousePos)) {
+            if (test3Btn.rect.contains(buttonPos) && !boardJob.running()) {
                 char *board = loadFile("boards/testboard3.brd");
                 if (board != nullptr) {
                     gameOverState = 0;
-                    gameBoard.loadBoard(board);
+                    revealJob.cancel();
+                    boardJob.startLoad(board);
+                    firstClickPending = false;
+                    firstClickQueued = false;
                 }
 
                 delete[] board;
             }
         }
 
+        // openings keep cascading between clicks
+        if (!gameOverState && !boardJob.running()) {
+            if (revealJob.running())
+                revealJob.step(gameBoard, revealBudgetMicros);
+
+            if (gameBoard.areWeWinners()) {
+                gameBoard.flagAllMines();
+                gameOverState = 2;// won!
+                showAllMines = false;
+            }
+        }
+
         // clear to black color
         window.clear(sf::Color::Black);
 
+        // hidden tile under the mouse gets highlighted
+        Vec2i hoveredTile;
+        const bool hovering = !gameOverState &&
+                gameBoard.mouseOverTile(hoveredTile, toCore(sf::Mouse::getPosition(window)));
+
         // draw game here
-        for (const Tile& tile : gameBoard.tiles) {
+        for (int i = 0; i < config.rows*config.cols; ++i) {
+            const Vec2i coords = gameBoard.layout.tileCoords(i);
+            const Tile& tile = gameBoard.accessTile(coords);
+            const FloatRect rect = gameBoard.layout.tileRect(coords);
             sf::Sprite sprite;
 
             {
@@ -531,17 +367,20 @@ int main(int argc, char *argv[])
                 const sf::Texture *tex = tile.isRevealed ? &tile_revealed_tex : &tile_hidden_tex;
                 sprite.setTexture(*tex);
                 auto size = tex->getSize();
-                sprite.setPosition(tile.rect.left, tile.rect.top);
-                sprite.setScale(1.0f/size.x * tile.rect.width, 1.0f/size.y * tile.rect.height);
+                sprite.setPosition(rect.left, rect.top);
+                sprite.setScale(1.0f/size.x * rect.width, 1.0f/size.y * rect.height);
+                if (hovering && !tile.isRevealed && coords == hoveredTile)
+                    sprite.setColor(sf::Color(200, 200, 255));
                 window.draw(sprite);
+                sprite.setColor(sf::Color::White);
             }
 
             if (tile.isMine && (gameOverState == 1 || showAllMines)) {
                 // mine hit, just display mine
                 sprite.setTexture(mineTex);
                 auto size = mineTex.getSize();
-                sprite.setPosition(tile.rect.left, tile.rect.top);
-                sprite.setScale(1.0f/size.x * tile.rect.width, 1.0f/size.y * tile.rect.height);
+                sprite.setPosition(rect.left, rect.top);
+                sprite.setScale(1.0f/size.x * rect.width, 1.0f/size.y * rect.height);
                 window.draw(sprite);
             }
 
@@ -550,8 +389,8 @@ int main(int argc, char *argv[])
 
                 sprite.setTexture(*num_tex);
                 auto size = num_tex->getSize();
-                sprite.setPosition(tile.rect.left, tile.rect.top);
-                sprite.setScale(1.0f/size.x * tile.rect.width, 1.0f/size.y * tile.rect.height);
+                sprite.setPosition(rect.left, rect.top);
+                sprite.setScale(1.0f/size.x * rect.width, 1.0f/size.y * rect.height);
                 window.draw(sprite);
             }
 
@@ -559,8 +398,8 @@ int main(int argc, char *argv[])
                 // render flag
                 sprite.setTexture(flag_tex);
                 auto size = flag_tex.getSize();
-                sprite.setPosition(tile.rect.left, tile.rect.top);
-                sprite.setScale(1.0f/size.x * tile.rect.width, 1.0f/size.y * tile.rect.height);
+                sprite.setPosition(rect.left, rect.top);
+                sprite.setScale(1.0f/size.x * rect.width, 1.0f/size.y * rect.height);
                 window.draw(sprite);
             }
 
@@ -610,6 +449,9 @@ int main(int argc, char *argv[])
 
         // end the current frame
         window.display();
+
+        // every tile is drawn each frame, so this frame's changes are consumed
+        gameBoard.changes.clear();
     }
 
     return 0;
@@ -0,0 +1,56 @@
+// generateBoards must give the same batch for any number of threads, and
+// board i must be the board GameBoard::generate(boardSeed(base, i)) gives.
+
+#include <cstdio>
+
+#include "BoardBatch.h"
+#include "GameBoard.h"
+#include "ThreadPool.h"
+
+namespace {
+
+int failures = 0;
+
+void check(bool ok, const char *what, int rows, int cols)
+{
+    if (!ok) {
+        std::printf("FAIL %s (%dx%d)\n", what, rows, cols);
+        failures++;
+    }
+}
+
+void checkBatch(const Config &cfg, size_t count)
+{
+    BoardBatch serial(cfg, count);
+    BoardBatch parallel(cfg, count);
+    ThreadPool onePool(1);
+    ThreadPool fourPool(4);
+    generateBoards(serial, 77, onePool);
+    generateBoards(parallel, 77, fourPool);
+    check(serial.data == parallel.data, "1 vs 4 threads", cfg.rows, cfg.cols);
+
+    GameBoard board(FloatRect{0,0,0,0}, cfg);
+    const int cells = cfg.rows*cfg.cols;
+    bool same = true;
+    for (size_t i = 0; i < count && i < 200; ++i) {
+        board.generate(BoardBatch::boardSeed(77, i));
+        for (int c = 0; c < cells; ++c) {
+            const Tile &tile = board.accessTile({c % cfg.cols, c / cfg.cols});
+            same = same && tile.isMine == serial.isMine(i, c) && tile.numNeighbors == serial.neighborCount(i, c);
+        }
+    }
+    check(same, "batch vs GameBoard::generate(boardSeed)", cfg.rows, cfg.cols);
+}
+
+}
+
+int main()
+{
+    checkBatch(Config{9, 9, 10, false}, 5000);
+    checkBatch(Config{16, 30, 99, false}, 20000);
+    checkBatch(Config{37, 130, 1500, false}, 500);
+
+    if (failures == 0)
+        std::printf("board batches ok\n");
+    return failures == 0 ? 0 : 1;
+}
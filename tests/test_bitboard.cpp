@@ -0,0 +1,93 @@
+// BitBoard::floodFill against GameBoard::floodFill on the same mines, after
+// the same random reveals and flags: revealed and flagged cells, flagCount
+// and the win check must agree, and the fill plane must be left clear.
+
+#include <cstdio>
+#include <string>
+
+#include "BitBoard.h"
+#include "GameBoard.h"
+#include "Rng.h"
+
+namespace {
+
+int failures = 0;
+
+void check(bool ok, const char *what, int rows, int cols)
+{
+    if (!ok) {
+        std::printf("FAIL %s (%dx%d)\n", what, rows, cols);
+        failures++;
+    }
+}
+
+void checkFlood(const Config &cfg, Rng &rng)
+{
+    GameBoard board(FloatRect{0,0,0,0}, cfg, rng.next());
+    std::string text;
+    for (int y = 0; y < cfg.rows; ++y) {
+        for (int x = 0; x < cfg.cols; ++x)
+            text += board.accessTile({x, y}).isMine ? '1' : '0';
+        text += '\n';
+    }
+    BitBoard bits(cfg);
+    bits.loadBoard(text.c_str());
+
+    // numbered cells revealed one at a time, and flags, before any fill
+    const int cells = cfg.rows*cfg.cols;
+    for (int k = 0; k < cells/10; ++k) {
+        const Vec2i coords = {static_cast<int>(rng.below(cfg.cols)), static_cast<int>(rng.below(cfg.rows))};
+        Tile &tile = board.accessTile(coords);
+        if (rng.below(2)) {
+            if (tile.numNeighbors == 0)
+                continue;
+            board.reveal(coords);
+            bits.reveal(coords);
+        } else {
+            if (!tile.isRevealed) {
+                tile.isFlagged = !tile.isFlagged;
+                board.flagCount += tile.isFlagged ? 1 : -1;
+            }
+            bits.toggleFlag(coords);
+        }
+    }
+    for (int k = 0; k < 5; ++k) {
+        const Vec2i coords = {static_cast<int>(rng.below(cfg.cols)), static_cast<int>(rng.below(cfg.rows))};
+        board.floodFill(coords);
+        bits.floodFill(coords);
+    }
+
+    check(board.flagCount == bits.flagCount, "flagCount", cfg.rows, cfg.cols);
+    check(board.areWeWinners() == bits.areWeWinners(), "areWeWinners()", cfg.rows, cfg.cols);
+    bool same = true;
+    for (int y = 0; y < cfg.rows; ++y) {
+        for (int x = 0; x < cfg.cols; ++x) {
+            const Tile &tile = board.accessTile({x, y});
+            same = same && tile.isRevealed == bits.isRevealed({x, y}) && tile.isFlagged == bits.isFlagged({x, y});
+        }
+    }
+    check(same, "revealed and flagged cells", cfg.rows, cfg.cols);
+    bool clear = true;
+    for (uint64_t word : bits.fillPlane)
+        clear = clear && word == 0;
+    check(clear, "fill plane cleared", cfg.rows, cfg.cols);
+}
+
+}
+
+int main()
+{
+    // odd widths and single words, rows of one and several words
+    const int sizes[][2] = {{9, 9}, {16, 30}, {37, 130}, {100, 64}, {64, 200}, {1, 1}, {3, 65}};
+    Rng rng(7);
+    for (const auto &size : sizes) {
+        for (int density = 0; density < 4; ++density) {
+            for (int rep = 0; rep < 15; ++rep)
+                checkFlood(Config{size[0], size[1], size[0]*size[1]*density/20, false}, rng);
+        }
+    }
+
+    if (failures == 0)
+        std::printf("bit board fills ok\n");
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,162 @@
+// Reveal paths against the serial GameBoard::floodFill on the same boards:
+// ParallelFlood with valid labels (region lists) and stale labels (chunk
+// rounds), and RevealJob stepped with a zero budget, on both storages, with
+// flags placed first so unflagging is covered too.
+
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+
+#include "GameBoard.h"
+#include "ParallelFlood.h"
+#include "RevealJob.h"
+#include "Rng.h"
+#include "ThreadPool.h"
+
+namespace {
+
+int failures = 0;
+
+void check(bool ok, const char *what, int run)
+{
+    if (!ok) {
+        std::printf("FAIL %s (run %d)\n", what, run);
+        failures++;
+    }
+}
+
+bool sameState(const GameBoard &a, const GameBoard &b)
+{
+    if (a.hiddenSafeCount != b.hiddenSafeCount || a.flagCount != b.flagCount)
+        return false;
+    for (size_t i = 0; i < a.tiles.size(); ++i) {
+        if (a.tiles[i].isRevealed != b.tiles[i].isRevealed || a.tiles[i].isFlagged != b.tiles[i].isFlagged)
+            return false;
+    }
+    return true;
+}
+
+std::vector<int> changedIndices(const GameBoard &board, bool sorted)
+{
+    std::vector<int> indices;
+    for (const TileChange &change : board.changes.entries)
+        indices.push_back(change.index);
+    if (sorted)
+        std::sort(indices.begin(), indices.end());
+    return indices;
+}
+
+// chunk rounds record chunk by chunk, so only the set of changes matches there
+bool sameChanges(const GameBoard &a, const GameBoard &b, bool ordered)
+{
+    return a.changes.fullRefresh == b.changes.fullRefresh
+        && changedIndices(a, !ordered) == changedIndices(b, !ordered);
+}
+
+// the same flags on both boards, then the change lists start empty
+void placeFlags(GameBoard &a, GameBoard &b, Rng &rng, int count)
+{
+    for (int i = 0; i < count; ++i) {
+        const Vec2i coords = {static_cast<int>(rng.below(a.cfg.cols)), static_cast<int>(rng.below(a.cfg.rows))};
+        a.toggleFlag(coords);
+        b.toggleFlag(coords);
+    }
+    a.changes.clear();
+    b.changes.clear();
+}
+
+Vec2i randomSafeCell(GameBoard &board, Rng &rng)
+{
+    for (;;) {
+        const Vec2i coords = {static_cast<int>(rng.below(board.cfg.cols)), static_cast<int>(rng.below(board.cfg.rows))};
+        if (!board.accessTile(coords).isMine)
+            return coords;
+    }
+}
+
+void checkParallelFlood(ThreadPool &pool)
+{
+    ParallelFlood parallel(pool);
+    Rng rng(1);
+    int parallelFills = 0;
+
+    // big enough that openings pass the parallel cut-over, sparse enough to have them
+    for (int run = 0; run < 8; ++run) {
+        const Config cfg = {600 + run*11, 700, (600 + run*11)*700/(run % 2 ? 400 : 2000), false};
+        const TileStorage storage = run % 4 < 2 ? TileStorage::RowMajor : TileStorage::Chunked;
+        GameBoard serial(FloatRect{0,0,0,0}, cfg, uint64_t(run), storage);
+        GameBoard board(FloatRect{0,0,0,0}, cfg, uint64_t(run), storage);
+        if (run % 3 == 0)
+            serial.changes.limit = board.changes.limit = size_t(1) << 30; // keep every entry
+        if (run % 2) {
+            serial.regions.valid = false; // chunk rounds instead of region lists
+            board.regions.valid = false;
+        }
+        placeFlags(serial, board, rng, 3000);
+
+        bool same = true;
+        for (int click = 0; click < 20; ++click) {
+            const Vec2i coords = randomSafeCell(serial, rng);
+            parallelFills += parallel.handles(board, coords);
+            serial.floodFill(coords);
+            parallel.floodFill(board, coords);
+            same = same && sameChanges(serial, board, board.regions.valid);
+        }
+        check(same, "ParallelFlood change list", run);
+        check(sameState(serial, board), "ParallelFlood tiles and counters", run);
+    }
+    check(parallelFills > 0 || pool.size() == 1, "ParallelFlood took the parallel path", 0);
+}
+
+void checkRevealJob()
+{
+    Rng rng(2);
+    for (int run = 0; run < 60; ++run) {
+        const Config cfg = {40, 70, run % 2 ? 100 : 300, false};
+        const TileStorage storage = run % 4 < 2 ? TileStorage::RowMajor : TileStorage::Chunked;
+        GameBoard serial(FloatRect{0,0,0,0}, cfg, uint64_t(run), storage);
+        GameBoard board(FloatRect{0,0,0,0}, cfg, uint64_t(run), storage);
+        if (run % 3 == 0) {
+            serial.regions.valid = false; // breadth-first instead of the region lists
+            board.regions.valid = false;
+        }
+        placeFlags(serial, board, rng, 100);
+
+        // clicks join a running cascade, some wait for it to finish
+        RevealJob job;
+        for (int click = 0; click < 6; ++click) {
+            const Vec2i coords = randomSafeCell(serial, rng);
+            serial.floodFill(coords);
+            job.start(board, coords);
+            if (click % 2)
+                while (!job.step(board, 0)) {}
+        }
+        while (!job.step(board, 0)) {}
+        check(sameState(serial, board), "RevealJob tiles and counters", run);
+
+        // chords: several seeds at once
+        int seeds[8];
+        bool hitMine = false;
+        for (int click = 0; click < 100; ++click) {
+            const Vec2i coords = {static_cast<int>(rng.below(cfg.cols)), static_cast<int>(rng.below(cfg.rows))};
+            const bool serialHit = serial.chord(coords);
+            job.start(board, seeds, board.chordSeeds(coords, seeds, hitMine));
+            while (!job.step(board, 0)) {}
+            check(serialHit == hitMine, "chordSeeds() mine hit", run);
+        }
+        check(sameState(serial, board), "RevealJob chords", run);
+    }
+}
+
+}
+
+int main()
+{
+    ThreadPool pool(4); // more threads than cores is fine, the split is what's tested
+    checkParallelFlood(pool);
+    checkRevealJob();
+
+    if (failures == 0)
+        std::printf("flood fills ok\n");
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,75 @@
+// addMine/removeMine/moveMine patch the neighbor counts in place; after a run
+// of random edits the board must match a fresh loadBoard() of the same mines,
+// and the sentinel ring must be left alone.
+
+#include <cstdio>
+#include <string>
+
+#include "GameBoard.h"
+#include "Rng.h"
+
+namespace {
+
+int failures = 0;
+
+void check(bool ok, const char *what, const char *storage)
+{
+    if (!ok) {
+        std::printf("FAIL %s (%s)\n", what, storage);
+        failures++;
+    }
+}
+
+void checkEdits(TileStorage storage, const char *name)
+{
+    const Config cfg = {20, 70, 200, false};
+    GameBoard board(FloatRect{0,0,0,0}, cfg, 5, storage);
+    GameBoard reference(FloatRect{0,0,0,0}, cfg, 5, storage);
+
+    Rng rng(9);
+    for (int i = 0; i < 5000; ++i) {
+        const Vec2i a = {static_cast<int>(rng.below(cfg.cols)), static_cast<int>(rng.below(cfg.rows))};
+        const Vec2i b = {static_cast<int>(rng.below(cfg.cols)), static_cast<int>(rng.below(cfg.rows))};
+        switch (rng.below(3)) {
+        case 0: board.addMine(a); break;
+        case 1: board.removeMine(a); break;
+        default: board.moveMine(a, b); break;
+        }
+    }
+
+    // the same mines as text, one line per row
+    std::string text;
+    for (int y = 0; y < cfg.rows; ++y) {
+        for (int x = 0; x < cfg.cols; ++x)
+            text += board.accessTile({x, y}).isMine ? '1' : '0';
+        text += '\n';
+    }
+    reference.loadBoard(&text[0]);
+
+    bool sameCounts = true;
+    for (int y = 0; y < cfg.rows; ++y) {
+        for (int x = 0; x < cfg.cols; ++x)
+            sameCounts = sameCounts && board.accessTile({x, y}).numNeighbors == reference.accessTile({x, y}).numNeighbors;
+    }
+    check(sameCounts, "neighbor counts", name);
+    check(board.mineCount == reference.mineCount, "mineCount", name);
+    check(board.hiddenSafeCount == reference.hiddenSafeCount, "hiddenSafeCount", name);
+    check(!board.seeded && !reference.seeded, "seed dropped by edits and loadBoard()", name);
+
+    bool sentinelsKept = true;
+    for (const Tile &tile : board.tiles)
+        sentinelsKept = sentinelsKept && (!tile.isRevealed || tile.numNeighbors == -1);
+    check(sentinelsKept, "sentinel ring", name);
+}
+
+}
+
+int main()
+{
+    checkEdits(TileStorage::RowMajor, "row-major");
+    checkEdits(TileStorage::Chunked, "chunked");
+
+    if (failures == 0)
+        std::printf("mine edits ok\n");
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,137 @@
+// Neighbor counting: the runtime-picked kernel (AVX2 where available) against
+// the portable one and a brute-force count, and GameBoard's counts after
+// generate() and mine edits, for widths that do and don't fill whole words.
+
+#include <cstdio>
+
+#include "GameBoard.h"
+#include "NeighborKernel.h"
+#include "Rng.h"
+
+namespace {
+
+int failures = 0;
+
+void check(bool ok, const char *what, int rows, int cols)
+{
+    if (!ok) {
+        std::printf("FAIL %s (%dx%d)\n", what, cols, rows);
+        failures++;
+    }
+}
+
+bool planeMine(const NeighborPlaneStore &store, int x, int y)
+{
+    if (x < 0 || y < 0 || x >= store.planes.cols || y >= store.planes.rows)
+        return false;
+    return (store.planes.mines[(y+1)*store.planes.stride + 1 + (x >> 6)] >> (x & 63)) & 1;
+}
+
+int planeCount(const NeighborPlaneStore &store, int x, int y)
+{
+    const int word = (y+1)*store.planes.stride + 1 + (x >> 6);
+    int count = 0;
+    for (int i = 0; i < 4; ++i)
+        count |= static_cast<int>((store.planes.counts[i][word] >> (x & 63)) & 1) << i;
+    return count;
+}
+
+int bruteCount(GameBoard &board, int x, int y)
+{
+    int count = 0;
+    for (int dy = -1; dy <= 1; ++dy) {
+        for (int dx = -1; dx <= 1; ++dx) {
+            if ((dx || dy) && board.coordsExist({x+dx,y+dy}) && board.accessTile({x+dx,y+dy}).isMine)
+                count++;
+        }
+    }
+    return count;
+}
+
+void checkKernels(int rows, int cols, double density, uint64_t seed)
+{
+    NeighborPlaneStore fast(rows, cols), portable(rows, cols);
+    Rng rng(seed);
+    for (int y = 0; y < rows; ++y) {
+        for (int x = 0; x < cols; ++x) {
+            if (rng.below(1000) < density*1000) {
+                fast.setMine(x, y);
+                portable.setMine(x, y);
+            }
+        }
+    }
+
+    computeNeighborBits(fast.planes);
+    computeNeighborBitsScalar(portable.planes);
+
+    bool same = true, correct = true;
+    for (int y = 0; y < rows; ++y) {
+        for (int x = 0; x < cols; ++x) {
+            int expected = 0;
+            for (int dy = -1; dy <= 1; ++dy) {
+                for (int dx = -1; dx <= 1; ++dx)
+                    expected += (dx || dy) && planeMine(fast, x+dx, y+dy);
+            }
+            if (planeMine(fast, x, y))
+                expected = 0;
+
+            same = same && planeCount(fast, x, y) == planeCount(portable, x, y);
+            correct = correct && planeCount(fast, x, y) == expected;
+        }
+    }
+    check(same, "picked kernel matches the portable one", rows, cols);
+    check(correct, "kernel matches a brute-force count", rows, cols);
+}
+
+void checkBoard(const Config &cfg, TileStorage storage, uint64_t seed)
+{
+    GameBoard board(FloatRect{0,0,0,0}, cfg, seed, storage);
+
+    bool correct = true;
+    int mines = 0;
+    for (int y = 0; y < cfg.rows; ++y) {
+        for (int x = 0; x < cfg.cols; ++x) {
+            const Tile &tile = board.accessTile({x,y});
+            mines += tile.isMine;
+            correct = correct && !tile.isRevealed && !tile.isFlagged &&
+                      (tile.isMine || tile.numNeighbors == bruteCount(board, x, y));
+        }
+    }
+    check(correct && mines == board.mineCount, "generate() counts", cfg.rows, cfg.cols);
+
+    // single edits keep counts incrementally, a full recount has to agree
+    Rng rng(seed);
+    for (int i = 0; i < 200; ++i) {
+        const Vec2i coords = {static_cast<int>(rng.below(cfg.cols)), static_cast<int>(rng.below(cfg.rows))};
+        if (!board.removeMine(coords))
+            board.addMine(coords);
+    }
+    std::vector<Tile> edited = board.tiles;
+    board.computeNeighbors();
+    bool same = true;
+    for (size_t i = 0; i < edited.size(); ++i)
+        same = same && (edited[i].isMine || edited[i].numNeighbors == board.tiles[i].numNeighbors);
+    check(same, "computeNeighbors() after mine edits", cfg.rows, cfg.cols);
+}
+
+}
+
+int main()
+{
+    const int sizes[][2] = {{1, 1}, {3, 63}, {5, 64}, {7, 65}, {40, 255}, {33, 256}, {64, 300}};
+    for (const auto &size : sizes) {
+        checkKernels(size[0], size[1], 0.2, size[0]*1000 + size[1]);
+        checkKernels(size[0], size[1], 0.9, size[0]*1000 + size[1] + 1);
+    }
+
+    // presets get the fixed-size kernels, the rest the dynamic or chunked ones
+    const Config configs[] = {{9,9,10,false}, {16,30,99,false}, {16,25,50,false}, {70,130,2000,false}, {100,63,5000,false}};
+    for (const Config &cfg : configs) {
+        checkBoard(cfg, TileStorage::RowMajor, 1);
+        checkBoard(cfg, TileStorage::Chunked, 2);
+    }
+
+    if (failures == 0)
+        std::printf("neighbor counts ok\n");
+    return failures == 0 ? 0 : 1;
+}